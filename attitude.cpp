@@ -0,0 +1,120 @@
+/*
+  attitude.cpp
+  ------------------------------------------------------
+  Fixed-point complementary filter. See attitude.h.
+*/
+#include "attitude.h"
+#include "imu.h"
+
+// Internal angle units per centidegree. 180° still fits
+// easily in int32 and a single gyro step keeps its
+// fractional part instead of truncating to zero.
+#define ATT_SCALE 4096
+
+#define ATT_HALF_TURN ((int32_t)18000 * ATT_SCALE)
+
+static int32_t roll = 0;
+static int32_t pitch = 0;
+static int32_t yaw = 0;
+static bool primed = false;
+
+/* =====================================================
+   INTEGER MATH
+   ===================================================== */
+
+// atan2 in centidegrees, error < 0.25°.
+// atan(z) ≈ 45°·z + 15.64°·z·(1 − z) on 0 ≤ z ≤ 1,
+// other octants by symmetry.
+static int32_t iatan2(int32_t y, int32_t x) {
+  if (x == 0 && y == 0) return 0;
+
+  uint32_t ux = x < 0 ? -x : x;
+  uint32_t uy = y < 0 ? -y : y;
+
+  bool steep = uy > ux;
+  uint32_t num = steep ? ux : uy;
+  uint32_t den = steep ? uy : ux;
+
+  int32_t z = (int32_t)(((uint64_t)num << 15) / den);   // Q15
+  int32_t a = (4500 * z + 1564 * ((z * (32768 - z)) >> 15)) >> 15;
+
+  if (steep) a = 9000 - a;
+  if (x < 0) a = 18000 - a;
+  return y < 0 ? -a : a;
+}
+
+static uint32_t isqrt(uint32_t v) {
+  uint32_t r = 0;
+  uint32_t bit = 1UL << 30;
+
+  while (bit > v) bit >>= 2;
+
+  while (bit != 0) {
+    if (v >= r + bit) {
+      v -= r + bit;
+      r = (r >> 1) + bit;
+    } else {
+      r >>= 1;
+    }
+    bit >>= 2;
+  }
+
+  return r;
+}
+
+// Keeps an angle in (−180°, 180°]
+static int32_t wrap(int32_t a) {
+  if (a > ATT_HALF_TURN) a -= 2 * ATT_HALF_TURN;
+  else if (a <= -ATT_HALF_TURN) a += 2 * ATT_HALF_TURN;
+  return a;
+}
+
+// Gyro LSB over one sample period -> internal angle units
+static inline int32_t gyroStep(int16_t rate) {
+  return (int32_t)((int64_t)rate * ATT_SCALE * 1000 /
+                   ((int32_t)IMU_GYRO_LSB_PER_DPS_X10 * IMU_RATE_HZ));
+}
+
+/* =====================================================
+   FILTER (one IMU sample)
+   ===================================================== */
+
+static void attitudeOnSample(const ImuSample& s) {
+
+  int32_t ay = s.ay;
+  int32_t az = s.az;
+
+  int32_t accRoll  = iatan2(ay, az) * ATT_SCALE;
+  uint32_t ayz2 = (uint32_t)(ay * ay) + (uint32_t)(az * az);
+  int32_t accPitch = iatan2(-(int32_t)s.ax, (int32_t)isqrt(ayz2)) * ATT_SCALE;
+
+  if (!primed) {
+    roll = accRoll;
+    pitch = accPitch;
+    yaw = 0;
+    primed = true;
+    return;
+  }
+
+  roll  = wrap(roll + gyroStep(s.gx));
+  pitch = pitch + gyroStep(s.gy);
+  yaw   = wrap(yaw + gyroStep(s.gz));
+
+  roll  = wrap(roll + (wrap(accRoll - roll) >> ATT_ACC_SHIFT));
+  pitch = pitch + ((accPitch - pitch) >> ATT_ACC_SHIFT);
+}
+
+/* =====================================================
+   PUBLIC
+   ===================================================== */
+
+void attitudeInit() {
+  if (imuPresent()) imuAddConsumer(attitudeOnSample);
+}
+
+void attitudeGet(Attitude& out) {
+  out.rollCdeg  = (int16_t)(roll / ATT_SCALE);
+  out.pitchCdeg = (int16_t)(pitch / ATT_SCALE);
+  out.yawCdeg   = (int16_t)(yaw / ATT_SCALE);
+  out.valid = primed;
+}
@@ -0,0 +1,41 @@
+/*
+  attitude.h
+  ------------------------------------------------------
+  On-device attitude estimate from the MPU-6050.
+
+  A complementary filter in integer arithmetic runs once
+  per IMU sample (IMU_RATE_HZ), fed straight from the
+  FIFO consumer hook:
+
+  • gyro rates are integrated into roll / pitch / yaw,
+  • roll and pitch are pulled toward the accelerometer
+    tilt by 1 / 2^ATT_ACC_SHIFT per sample (time constant
+    2^ATT_ACC_SHIFT / IMU_RATE_HZ seconds).
+
+  Yaw has no absolute reference (no magnetometer), so it
+  is gyro-only and drifts slowly.
+
+  Angles are in centidegrees. Sent to the app as an
+  OrientationPacket (CC 99) and readable by the control
+  layer through attitudeGet().
+*/
+#ifndef ATTITUDE_H
+#define ATTITUDE_H
+
+#include <Arduino.h>
+
+#define ATT_ACC_SHIFT 7     // 128 samples, ~0.64 s at 200 Hz
+
+struct Attitude {
+  int16_t rollCdeg;    // -18000 .. 18000, right side down positive
+  int16_t pitchCdeg;   // -9000 .. 9000, nose up positive
+  int16_t yawCdeg;     // -18000 .. 18000, relative to boot
+  bool valid;          // false until the first IMU sample
+};
+
+// Subscribes to IMU samples; call after imuInit()
+void attitudeInit();
+
+void attitudeGet(Attitude& out);
+
+#endif
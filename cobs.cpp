@@ -0,0 +1,55 @@
+/*
+  cobs.cpp
+  ------------------------------------------------------
+  COBS encoder / decoder. See cobs.h.
+*/
+#include "cobs.h"
+
+size_t cobsEncode(const uint8_t* in, size_t len, uint8_t* out) {
+  size_t codeIndex = 0;   // where the current block's code byte goes
+  size_t o = 1;
+  uint8_t code = 1;
+
+  for (size_t i = 0; i < len; i++) {
+    if (in[i] == 0) {
+      out[codeIndex] = code;
+      codeIndex = o++;
+      code = 1;
+    } else {
+      out[o++] = in[i];
+      code++;
+
+      if (code == 0xFF) {
+        out[codeIndex] = code;
+        codeIndex = o++;
+        code = 1;
+      }
+    }
+  }
+
+  out[codeIndex] = code;
+  return o;
+}
+
+size_t cobsDecode(const uint8_t* in, size_t len, uint8_t* out) {
+  size_t i = 0;
+  size_t o = 0;
+
+  while (i < len) {
+    uint8_t code = in[i++];
+
+    if (code == 0 || i + code - 1 > len) return 0;
+
+    for (uint8_t k = 1; k < code; k++) {
+      if (in[i] == 0) return 0;
+      out[o++] = in[i++];
+    }
+
+    // A code below 0xFF ends with an implicit zero, except
+    // at the very end of the frame
+    if (code < 0xFF && i < len)
+      out[o++] = 0;
+  }
+
+  return o;
+}
@@ -0,0 +1,32 @@
+/*
+  cobs.h
+  ------------------------------------------------------
+  Consistent Overhead Byte Stuffing (COBS) codec.
+
+  Purpose:
+  --------
+  Removes every 0x00 from a packet so 0x00 can be used
+  as an unambiguous frame delimiter on the Bluetooth
+  link. Overhead is 1 byte per 254 bytes of payload
+  (plus the delimiter, which the caller appends).
+
+  This file has no Arduino dependencies.
+*/
+#ifndef COBS_H
+#define COBS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Worst-case encoded size (without the 0x00 delimiter) */
+#define COBS_MAX_ENCODED(len) ((len) + ((len) / 254) + 1)
+
+// Encodes len bytes into out (must hold COBS_MAX_ENCODED(len)).
+// Returns encoded length. Output contains no 0x00.
+size_t cobsEncode(const uint8_t* in, size_t len, uint8_t* out);
+
+// Decodes len bytes (without delimiter) into out (must hold len).
+// Returns decoded length, or 0 if the input is malformed.
+size_t cobsDecode(const uint8_t* in, size_t len, uint8_t* out);
+
+#endif
@@ -46,17 +46,131 @@
 #include "control.h"
 #include "packets.h"
 #include "hal_outputs.h"
+#include "event_queue.h"
+#include "latency.h"
+#include "failsafe.h"
+#include "fast_map.h"
+#include "curves.h"
+#include "mixer.h"
+#include "output_stage.h"
+#include "telemetry.h"
+#include "mcp_io.h"
 
 /* =====================================================
    INTERNAL HELPERS
    ===================================================== */
 
+// Same results as map(v, 0, 4095, lo, hi), see fast_map.h
 static uint32_t mapServo(uint16_t v) {
-  return map(v, 0, 4095, 3277, 6553);
+  return FastMap<3277, 6553>::apply(v);
 }
 
 static uint32_t mapMotor(uint16_t v) {
-  return map(v, 0, 4095, 0, 255);
+  return FastMap<0, 255>::apply(v);
+}
+
+static uint32_t mapKnob(uint16_t v) {
+  return FastMap<0, 255>::apply(v);
+}
+
+/* =====================================================
+   DIRTY-TRACKED OUTPUT COMMIT
+
+   The last value written to each output is remembered and
+   hardware is only touched when it changes. In MCP mode
+   each halSetSwitch() is an I2C transaction, so idle
+   sticks/switches cost no bus time at all.
+   ===================================================== */
+
+typedef void (*HalPwmSetter)(uint32_t value);
+
+static const HalPwmSetter pwmSetters[CH_COUNT] = {
+  halSetSteering,
+  halSetMotorLeft,
+  halSetMotorRight,
+  halSetCameraPan,
+  halSetLed,
+  halSetBuzzer
+};
+
+static uint32_t lastPwm[CH_COUNT];
+static byte lastSwitches = 0;
+static bool pwmCommitted = false;        // false = force first write
+static bool switchesCommitted = false;
+
+// PWM may be committed from the output stage timer task
+// while switches are committed from the main loop
+static portMUX_TYPE statsMux = portMUX_INITIALIZER_UNLOCKED;
+static ControlStats stats = {0, 0};
+
+static void countWrites(uint32_t applied, uint32_t skipped) {
+  portENTER_CRITICAL(&statsMux);
+  stats.writesApplied += applied;
+  stats.writesSkipped += skipped;
+  portEXIT_CRITICAL(&statsMux);
+}
+
+// Returns true if the output was written
+static bool commitPwm(uint8_t channel, uint32_t value) {
+  if (pwmCommitted && lastPwm[channel] == value) return false;
+
+  pwmSetters[channel](value);
+  lastPwm[channel] = value;
+  return true;
+}
+
+static void commitSwitches(byte sw) {
+  byte changed = switchesCommitted ? (byte)(sw ^ lastSwitches) : 0x3F;
+  uint32_t applied = 0;
+
+  for (int i = 0; i < 6; i++) {
+    if (changed & (1 << i)) {
+      halSetSwitch(i, sw & (1 << i));
+      applied++;
+    }
+  }
+
+  lastSwitches = sw;
+  switchesCommitted = true;
+  countWrites(applied, 6 - applied);
+}
+
+/* =====================================================
+   EVENT STATE
+   ===================================================== */
+
+#define PRESET_NONE 0xFFFF
+
+static EventAction eventActions[256];
+
+static byte switchToggleMask = 0;           // ACT_TOGGLE_SWITCH
+static uint16_t presets[CH_COUNT];          // ACT_PWM_PRESET
+
+static void eventActionsInit() {
+  memset(eventActions, 0, sizeof(eventActions));
+
+  // Defaults match the original hard-coded events
+  eventActions[0x01] = { ACT_PULSE, 0, 50 };
+  eventActions[0x02] = { ACT_PULSE, 1, 50 };
+  eventActions[0x03] = { ACT_PULSE, 0, 50 };
+  eventActions[0x04] = { ACT_PULSE, 1, 50 };
+
+  switchToggleMask = 0;
+  for (uint8_t i = 0; i < CH_COUNT; i++) presets[i] = PRESET_NONE;
+}
+
+/* =====================================================
+   INIT
+   ===================================================== */
+
+void controlInit() {
+  eventActionsInit();
+  curvesInit();
+  mixerInit();
+
+#if OUTPUT_STAGE_ENABLED
+  outputStageInit();
+#endif
 }
 
 /* =====================================================
@@ -65,24 +179,83 @@ static uint32_t mapMotor(uint16_t v) {
 
 void controlUpdate() {
 
-  uint32_t steerPWM = mapServo(rcStatePacket.data.leftStickX);
-  uint32_t motorL   = mapMotor(rcStatePacket.data.leftStickY);
-  uint32_t motorR   = mapMotor(rcStatePacket.data.rightStickY);
-  uint32_t panPWM   = mapServo(rcStatePacket.data.rightStickX);
+  static int8_t eventConsumer = eventQueueSubscribe();
+  RcEvent ev;
 
-  halSetSteering(steerPWM);
-  halSetMotorLeft(motorL);
-  halSetMotorRight(motorR);
-  halSetCameraPan(panPWM);
+  while (eventQueuePop(eventConsumer, ev)) {
+    controlHandleEvent(ev.eventId);
+  }
 
-  halSetLed(map(rcStatePacket.data.leftKnob, 0, 4095, 0, 255));
-  halSetBuzzer(map(rcStatePacket.data.rightKnob, 0, 4095, 0, 255));
+  uint16_t ch[CH_COUNT];
+  ch[CH_STEERING]   = rcStatePacket.data.leftStickX;
+  ch[CH_MOTOR_L]    = rcStatePacket.data.leftStickY;
+  ch[CH_MOTOR_R]    = rcStatePacket.data.rightStickY;
+  ch[CH_CAMERA_PAN] = rcStatePacket.data.rightStickX;
+  ch[CH_LED]        = rcStatePacket.data.leftKnob;
+  ch[CH_BUZZER]     = rcStatePacket.data.rightKnob;
 
   byte sw = rcStatePacket.data.switches;
 
-  for (int i = 0; i < 6; i++) {
-    halSetSwitch(i, sw & (1 << i));
-  }
+  // Expo / deadband / trim / endpoints (one lookup per channel)
+  for (uint8_t i = 0; i < CH_COUNT; i++)
+    ch[i] = curveApply(i, ch[i]);
+
+  // Arcade/tank, elevon, pan/tilt coupling ...
+  mixerApply(ch);
+
+  // Event-driven overrides
+  for (uint8_t i = 0; i < CH_COUNT; i++)
+    if (presets[i] != PRESET_NONE) ch[i] = presets[i];
+
+  sw ^= switchToggleMask;
+
+  // Link lost: substitute per-channel safe values
+  failsafeApply(ch, sw);
+
+  OutputMarks marks;
+  marks.rx = latencyTakeRx(marks.rxUs);
+  marks.trip = failsafeTakeTrip(marks.lastFrameUs);
+
+#if OUTPUT_STAGE_ENABLED
+  // PWM is written (and stamped) by the fixed-rate output
+  // stage; failsafe values bypass its slew limits
+  outputStageSetTargets(ch, failsafeGetStats().active, marks);
+#else
+  controlCommitPwm(ch);
+#endif
+
+  commitSwitches(sw);
+
+#if USE_MCP23017
+  // One bus burst for every switch change this tick
+  mcpSync();
+
+  if (mcpTakeInputChange()) telemetryRequestIndicator();
+#endif
+
+#if !OUTPUT_STAGE_ENABLED
+  if (marks.rx) latencyRecord(marks.rxUs);
+  if (marks.trip) failsafeMarkSafe(marks.lastFrameUs);
+#endif
+}
+
+void controlCommitPwm(const uint16_t ch[CH_COUNT]) {
+  uint32_t applied = 0;
+
+  applied += commitPwm(CH_STEERING,   mapServo(ch[CH_STEERING]));
+  applied += commitPwm(CH_MOTOR_L,    mapMotor(ch[CH_MOTOR_L]));
+  applied += commitPwm(CH_MOTOR_R,    mapMotor(ch[CH_MOTOR_R]));
+  applied += commitPwm(CH_CAMERA_PAN, mapServo(ch[CH_CAMERA_PAN]));
+
+  applied += commitPwm(CH_LED,    mapKnob(ch[CH_LED]));
+  applied += commitPwm(CH_BUZZER, mapKnob(ch[CH_BUZZER]));
+
+  pwmCommitted = true;
+  countWrites(applied, CH_COUNT - applied);
+}
+
+const ControlStats& controlGetStats() {
+  return stats;
 }
 
 /* =====================================================
@@ -91,11 +264,35 @@ void controlUpdate() {
 
 void controlHandleEvent(byte eventId) {
 
-  switch (eventId) {
-    case 0x01: halPulseSwitch(0); break;
-    case 0x02: halPulseSwitch(1); break;
-    case 0x03: halPulseSwitch(0); break;
-    case 0x04: halPulseSwitch(1); break;
-    default: break;
+  const EventAction& a = eventActions[eventId];
+
+  switch (a.type) {
+    case ACT_PULSE:
+      halPulseSwitch(a.target, a.param);
+      break;
+
+    case ACT_TOGGLE_SWITCH:
+      if (a.target < 6) switchToggleMask ^= (1 << a.target);
+      break;
+
+    case ACT_PWM_PRESET:
+      if (a.target < CH_COUNT)
+        presets[a.target] = (a.param == PRESET_NONE || a.param <= 4095) ? a.param : 4095;
+      break;
+
+    case ACT_TELEMETRY_SNAPSHOT:
+      telemetryRequestSnapshot();
+      break;
+
+    default:
+      break;
   }
+}
+
+void controlSetEventAction(byte eventId, const EventAction& action) {
+  eventActions[eventId] = action;
+}
+
+const EventAction& controlGetEventAction(byte eventId) {
+  return eventActions[eventId];
 }
\ No newline at end of file
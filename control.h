@@ -3,7 +3,18 @@
 
 #include <Arduino.h>
 
-// Initialize all hardware outputs
+/* Channel order used by the control layer */
+enum ControlChannel : uint8_t {
+  CH_STEERING,    // leftStickX
+  CH_MOTOR_L,     // leftStickY
+  CH_MOTOR_R,     // rightStickY
+  CH_CAMERA_PAN,  // rightStickX
+  CH_LED,         // leftKnob
+  CH_BUZZER,      // rightKnob
+  CH_COUNT
+};
+
+// Initialize control layer state (curves, mixer)
 void controlInit();
 
 // Called every loop to apply RC state to hardware
@@ -12,4 +23,37 @@ void controlUpdate();
 // Called when an EventPacket is received
 void controlHandleEvent(byte eventId);
 
+/* =====================================================
+   EVENT -> ACTION TABLE (one entry per event id)
+   ===================================================== */
+
+enum EventActionType : uint8_t {
+  ACT_NONE,
+  ACT_PULSE,          // target = pulse output, param = ms
+  ACT_TOGGLE_SWITCH,  // target = switch 0–5 (inverts app state)
+  ACT_PWM_PRESET,     // target = channel, param = 0–4095, 0xFFFF = release
+  ACT_TELEMETRY_SNAPSHOT
+};
+
+struct EventAction {
+  uint8_t type;       // EventActionType
+  uint8_t target;
+  uint16_t param;
+};
+
+void controlSetEventAction(byte eventId, const EventAction& action);
+const EventAction& controlGetEventAction(byte eventId);
+
+// Output write counters (hardware touched only on change)
+struct ControlStats {
+  uint32_t writesApplied;
+  uint32_t writesSkipped;
+};
+
+const ControlStats& controlGetStats();
+
+// Maps channel values (0–4095) and writes changed PWM outputs.
+// Called by controlUpdate(), or by the output stage timer.
+void controlCommitPwm(const uint16_t ch[CH_COUNT]);
+
 #endif
\ No newline at end of file
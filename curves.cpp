@@ -0,0 +1,109 @@
+/*
+  curves.cpp
+  ------------------------------------------------------
+  Curve table builder and lookup. See curves.h.
+*/
+#include "curves.h"
+
+#define CURVE_POINTS     257                // 256 segments + end point
+#define CURVE_SHIFT      4                  // 4096 / 256 = 16 units per segment
+#define CURVE_FRAC_MASK  ((1 << CURVE_SHIFT) - 1)
+#define CURVE_IN_MAX     4095
+#define CURVE_CENTER     2048
+
+/* =====================================================
+   DEFAULT PARAMETERS (identity)
+   ===================================================== */
+
+static const CurveParams curveDefaults[CH_COUNT] = {
+  // centered expo deadband trim epLow epHigh
+  { true,    0,   0,       0,   100,  100 },   // steering
+  { true,    0,   0,       0,   100,  100 },   // motor L
+  { true,    0,   0,       0,   100,  100 },   // motor R
+  { true,    0,   0,       0,   100,  100 },   // camera pan
+  { false,   0,   0,       0,   100,  100 },   // LED knob
+  { false,   0,   0,       0,   100,  100 },   // buzzer knob
+};
+
+static CurveParams curveParams[CH_COUNT];
+
+// Point i is the output for input i * 16. The last point is
+// for 4096 so interpolation near the top stays exact; it
+// may hold 4096 and is clamped on output.
+static uint16_t curveTable[CH_COUNT][CURVE_POINTS];
+
+/* =====================================================
+   BUILD (floats allowed, runs on config change only)
+   ===================================================== */
+
+static float curveShape(const CurveParams& p, float n) {
+  float e = p.expoPct / 100.0f;
+  return (1.0f - e) * n + e * n * n * n;
+}
+
+static float curveEval(const CurveParams& p, int32_t x) {
+  float y;
+
+  if (p.centered) {
+    int32_t d = x - CURVE_CENTER;
+    int32_t mag = d < 0 ? -d : d;
+    float n = 0.0f;
+
+    if (mag > p.deadband && p.deadband < CURVE_CENTER)
+      n = (float)(mag - p.deadband) / (float)(CURVE_CENTER - p.deadband);
+
+    n = curveShape(p, n);
+    n *= (d < 0 ? p.endpointLow : p.endpointHigh) / 100.0f;
+
+    y = CURVE_CENTER + (d < 0 ? -n : n) * CURVE_CENTER;
+  } else {
+    float n = 0.0f;
+
+    if (x > p.deadband && p.deadband < CURVE_IN_MAX + 1)
+      n = (float)(x - p.deadband) / (float)(CURVE_IN_MAX + 1 - p.deadband);
+
+    n = curveShape(p, n) * (p.endpointHigh / 100.0f);
+    y = n * (CURVE_IN_MAX + 1);
+  }
+
+  y += p.trim;
+
+  if (y < 0.0f) return 0.0f;
+  if (y > CURVE_IN_MAX + 1) return CURVE_IN_MAX + 1;
+  return y;
+}
+
+void curveSetParams(uint8_t channel, const CurveParams& p) {
+  if (channel >= CH_COUNT) return;
+
+  curveParams[channel] = p;
+
+  for (int32_t i = 0; i < CURVE_POINTS; i++)
+    curveTable[channel][i] = (uint16_t)(curveEval(p, i << CURVE_SHIFT) + 0.5f);
+}
+
+const CurveParams& curveGetParams(uint8_t channel) {
+  return curveParams[channel < CH_COUNT ? channel : 0];
+}
+
+void curvesInit() {
+  for (uint8_t i = 0; i < CH_COUNT; i++)
+    curveSetParams(i, curveDefaults[i]);
+}
+
+/* =====================================================
+   HOT PATH
+   ===================================================== */
+
+uint16_t curveApply(uint8_t channel, uint16_t value) {
+  if (value > CURVE_IN_MAX) value = CURVE_IN_MAX;
+
+  const uint16_t* t = curveTable[channel];
+  uint16_t idx = value >> CURVE_SHIFT;
+  int32_t a = t[idx];
+  int32_t b = t[idx + 1];
+
+  int32_t y = a + (((b - a) * (int32_t)(value & CURVE_FRAC_MASK)) >> CURVE_SHIFT);
+
+  return y > CURVE_IN_MAX ? CURVE_IN_MAX : (uint16_t)y;
+}
@@ -0,0 +1,40 @@
+/*
+  curves.h
+  ------------------------------------------------------
+  Per-channel stick/knob response curves.
+
+  Each control channel has a CurveParams set (expo,
+  center deadband, trim, endpoints). When the parameters
+  change, curveSetParams() compiles them into a 257-point
+  fixed-point table. The control hot path is then one
+  table lookup plus a 4-bit linear interpolation per
+  channel, no floats.
+
+  Values in and out are RcPacket units (0–4095).
+  Default parameters give an exact identity curve.
+*/
+#ifndef CURVES_H
+#define CURVES_H
+
+#include <Arduino.h>
+#include "control.h"
+
+struct CurveParams {
+  bool    centered;      // true: stick centered at 2048, false: 0-based (knob)
+  uint8_t expoPct;       // 0 = linear, 100 = full cubic
+  uint16_t deadband;     // units around center (or above 0) mapped to center (or 0)
+  int16_t trim;          // units added after the curve
+  uint8_t endpointLow;   // % of travel below center (centered only)
+  uint8_t endpointHigh;  // % of travel above center (or of full range)
+};
+
+void curvesInit();
+
+// Rebuilds the table for one channel (not for the hot path)
+void curveSetParams(uint8_t channel, const CurveParams& p);
+const CurveParams& curveGetParams(uint8_t channel);
+
+// Hot path: applies channel's curve to a 0–4095 value
+uint16_t curveApply(uint8_t channel, uint16_t value);
+
+#endif
@@ -14,6 +14,7 @@
 #include "debug.h"
 #include "packets.h"
 #include "debug_config.h"
+#include "event_queue.h"
 // Incluye prototipos y variables globales
 
 /* ---------- LAST VALUES ---------- */
@@ -113,19 +114,151 @@ void debugSwitches() {
 /* ---------- EVENTS ---------- */
 #if DBG_EVENTS
 void printEventPacketOnPress() {
-  uint8_t v = rcEventPacket.data.eventId;
+  static int8_t consumer = eventQueueSubscribe();
+  static uint32_t lastMissed = 0;
+  RcEvent ev;
 
-  if (!eventPacketArrived)
+  // Print every event that arrived since last call
+  while (eventQueuePop(consumer, ev)) {
+    Serial.println("\n--- EVENT PACKET (PRESS) ---");
+    Serial.printf("Event ID: 0x%02X\n", ev.eventId);
+    Serial.printf("Seq: %lu  Rx: %lu us\n",
+                  (unsigned long)ev.seq, (unsigned long)ev.rxUs);
+    Serial.println("----------------------------");
+  }
+
+  if (consumer < 0) return;
+
+  uint32_t missed = eventQueueGetStats().missed[consumer];
+  if (missed != lastMissed) {
+    Serial.printf("Events missed by debug printer: %lu\n", (unsigned long)missed);
+    lastMissed = missed;
+  }
+}
+#endif
+
+/* ---------- RX STATS ---------- */
+#if DBG_RX_STATS
+#include "receiver.h"
+
+static uint32_t lastBadFrames = 0;
+static uint32_t lastResyncs = 0;
+
+void debugReceiverStats() {
+  const ReceiverStats& st = receiverGetStats();
+
+  // Only print when something went wrong on the link
+  if (st.badFrames == lastBadFrames && st.resyncs == lastResyncs)
+    return;
+
+  Serial.printf("RX good: %lu  bad: %lu  resync: %lu  coalesced: %lu\n",
+                (unsigned long)st.goodFrames,
+                (unsigned long)st.badFrames,
+                (unsigned long)st.resyncs,
+                (unsigned long)st.coalesced);
+  Serial.printf("RX bytes: %lu  reads: %lu  drops: %lu  last: %lu us  max: %lu us\n",
+                (unsigned long)st.bytesIn,
+                (unsigned long)st.bulkReads,
+                (unsigned long)st.handoffDrops,
+                (unsigned long)st.lastCallUs,
+                (unsigned long)st.maxCallUs);
+
+  lastBadFrames = st.badFrames;
+  lastResyncs = st.resyncs;
+}
+#endif
+
+/* ---------- LATENCY ---------- */
+#if DBG_LATENCY
+#include "latency.h"
+#include "control.h"
+
+static unsigned long lastLatencyPrint = 0;
+
+void debugLatency() {
+  if (millis() - lastLatencyPrint < 5000)
+    return;
+
+  lastLatencyPrint = millis();
+
+  const ControlStats& cs = controlGetStats();
+  Serial.printf("Output writes  applied: %lu  skipped: %lu\n",
+                (unsigned long)cs.writesApplied,
+                (unsigned long)cs.writesSkipped);
+
+  LatencySummary lat;
+  latencyGetSummary(lat);
+
+  if (lat.count == 0)
     return;
 
-  eventPacketArrived = false;  // consume event
+  Serial.printf("RX->OUT latency  n: %lu  p50: %lu us  p99: %lu us  max: %lu us\n",
+                (unsigned long)lat.count,
+                (unsigned long)lat.p50Us,
+                (unsigned long)lat.p99Us,
+                (unsigned long)lat.maxUs);
+}
+#endif
+
+/* ---------- FAILSAFE ---------- */
+#if DBG_FAILSAFE
+#include "failsafe.h"
+
+static bool lastFailsafeActive = false;
+static bool rampReported = true;
+static bool lossReported = true;
+
+void debugFailsafe() {
+  const FailsafeStats& fs = failsafeGetStats();
+
+  if (fs.active != lastFailsafeActive) {
+    if (fs.active) {
+      Serial.printf("FAILSAFE ON  (trip %lu)\n", (unsigned long)fs.trips);
+      rampReported = false;
+      lossReported = false;
+    } else {
+      Serial.println("FAILSAFE OFF (link restored)");
+    }
+    lastFailsafeActive = fs.active;
+  }
 
-  // Print every time an event packet arrives
-  Serial.println("\n--- EVENT PACKET (PRESS) ---");
-  Serial.printf("Event ID: 0x%02X\n", v);
-  Serial.printf("Checksum: 0x%02X\n", rcEventPacket.data.checksum);
-  Serial.println("----------------------------");
+  // Stamped when the first safe values are written, which
+  // with the output stage is a tick after the trip is seen
+  if (!lossReported && fs.lastLossToSafeUs != 0) {
+    Serial.printf("FAILSAFE loss->safe %lu us\n", (unsigned long)fs.lastLossToSafeUs);
+    lossReported = true;
+  }
 
+  if (!rampReported && fs.lastRampMs != 0) {
+    Serial.printf("FAILSAFE ramp complete in %lu ms\n", (unsigned long)fs.lastRampMs);
+    rampReported = true;
+  }
 }
 #endif
 
+#if DBG_MCP_STATS && USE_MCP23017
+#include "mcp_io.h"
+
+static unsigned long lastMcpPrint = 0;
+
+void debugMcpStats() {
+  if (millis() - lastMcpPrint < 1000) return;
+  lastMcpPrint = millis();
+
+  const McpStats& st = mcpGetStats();
+
+  uint8_t present = 0;
+  for (uint8_t i = 0; i < mcpDeviceCount(); i++)
+    if (mcpDevicePresent(i)) present++;
+
+  Serial.printf("MCP dev: %u/%u  scans: %lu  int: %lu  wr: %lu  rd: %lu  merged: %lu\n",
+                present, mcpDeviceCount(),
+                (unsigned long)st.scans,
+                (unsigned long)st.interrupts,
+                (unsigned long)st.writeBursts,
+                (unsigned long)st.readBursts,
+                (unsigned long)st.writesMerged);
+  Serial.printf("MCP bus: %u us/tick  max: %u us\n",
+                st.tickBusUs, st.maxTickBusUs);
+}
+#endif
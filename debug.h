@@ -40,4 +40,20 @@ void debugSwitches();
 void printEventPacketOnPress();
 #endif
 
+#if DBG_RX_STATS
+void debugReceiverStats();
+#endif
+
+#if DBG_LATENCY
+void debugLatency();
+#endif
+
+#if DBG_FAILSAFE
+void debugFailsafe();
+#endif
+
+#if DBG_MCP_STATS && USE_MCP23017
+void debugMcpStats();
+#endif
+
 #endif
@@ -12,11 +12,19 @@
   #define DBG_KNOBS    1
   #define DBG_SWITCHES 1
   #define DBG_EVENTS   1
+  #define DBG_RX_STATS 1
+  #define DBG_LATENCY  1
+  #define DBG_FAILSAFE 1
+  #define DBG_MCP_STATS 1
 #else
   #define DBG_STICKS   0
   #define DBG_KNOBS    0
   #define DBG_SWITCHES 0
   #define DBG_EVENTS   0
+  #define DBG_RX_STATS 0
+  #define DBG_LATENCY  0
+  #define DBG_FAILSAFE 0
+  #define DBG_MCP_STATS 0
 #endif
 
 
@@ -0,0 +1,57 @@
+/*
+  event_queue.cpp
+  ------------------------------------------------------
+  Broadcast ring of RcEvent with one cursor per consumer.
+  See event_queue.h.
+*/
+#include "event_queue.h"
+
+#define EVENT_QUEUE_MASK (EVENT_QUEUE_SIZE - 1)
+
+static RcEvent events[EVENT_QUEUE_SIZE];
+static uint32_t writeSeq = 0;                      // seq of next event
+static uint32_t readSeq[EVENT_MAX_CONSUMERS];      // next seq per consumer
+static uint8_t consumerCount = 0;
+
+static EventQueueStats stats = {};
+
+int8_t eventQueueSubscribe() {
+  if (consumerCount >= EVENT_MAX_CONSUMERS) return -1;
+
+  readSeq[consumerCount] = writeSeq;
+  return (int8_t)consumerCount++;
+}
+
+void eventQueuePush(byte eventId, uint32_t rxUs) {
+  RcEvent& e = events[writeSeq & EVENT_QUEUE_MASK];
+
+  e.seq = writeSeq;
+  e.rxUs = rxUs;
+  e.eventId = eventId;
+
+  writeSeq++;
+  stats.pushed++;
+}
+
+bool eventQueuePop(int8_t consumer, RcEvent& out) {
+  if (consumer < 0 || consumer >= consumerCount) return false;
+
+  uint32_t& rd = readSeq[consumer];
+  uint32_t pending = writeSeq - rd;
+
+  if (pending == 0) return false;
+
+  if (pending > EVENT_QUEUE_SIZE) {
+    // Consumer fell behind: skip to the oldest event still stored
+    stats.missed[consumer] += pending - EVENT_QUEUE_SIZE;
+    rd = writeSeq - EVENT_QUEUE_SIZE;
+  }
+
+  out = events[rd & EVENT_QUEUE_MASK];
+  rd++;
+  return true;
+}
+
+const EventQueueStats& eventQueueGetStats() {
+  return stats;
+}
@@ -0,0 +1,55 @@
+/*
+  event_queue.h
+  ------------------------------------------------------
+  Bounded broadcast FIFO for inbound EventPackets.
+
+  Purpose:
+  --------
+  receiver.cpp pushes every valid EventPacket here with
+  its arrival timestamp and a sequence number. Each
+  consumer (control layer, debug printer, ...) holds its
+  own read cursor, so every consumer sees every event in
+  order, and two events in the same loop never overwrite
+  each other.
+
+  Overflow:
+  ---------
+  The writer never blocks. If a consumer falls more than
+  EVENT_QUEUE_SIZE events behind, the oldest unread
+  events are skipped and added to that consumer's
+  'missed' counter. Sequence numbers also let a consumer
+  spot the gap itself.
+*/
+#ifndef EVENT_QUEUE_H
+#define EVENT_QUEUE_H
+
+#include <Arduino.h>
+
+#define EVENT_QUEUE_SIZE      16   // power of two
+#define EVENT_MAX_CONSUMERS   4
+
+struct RcEvent {
+  uint32_t seq;       // increments by 1 per received event
+  uint32_t rxUs;      // micros() when the framer completed the frame
+  byte eventId;
+};
+
+struct EventQueueStats {
+  uint32_t pushed;                        // events received
+  uint32_t missed[EVENT_MAX_CONSUMERS];   // lost per consumer (overflow)
+};
+
+// Returns a consumer id, or -1 if all slots are taken.
+// A new consumer starts at the next event pushed.
+int8_t eventQueueSubscribe();
+
+// rxUs: frame completion time, not handler dispatch time,
+// so queueing in front of the main loop is not counted
+void eventQueuePush(byte eventId, uint32_t rxUs);
+
+// Oldest unread event for this consumer; false if none.
+bool eventQueuePop(int8_t consumer, RcEvent& out);
+
+const EventQueueStats& eventQueueGetStats();
+
+#endif
@@ -0,0 +1,111 @@
+/*
+  bench_bt_read.cpp
+  ------------------------------------------------------
+  Per-byte SerialBT.read() vs bulk SerialBT.readBytes()
+  when draining the Bluetooth stand-in into a 64-byte
+  ring, the way receiver.cpp did before and after the
+  bulk-read change.
+
+  The stand-in takes a lock on every call (as the real
+  driver's RX queue does), so the per-call overhead that
+  bulk reads remove shows up here. The last line runs
+  the real handleBluetooth() on the same backlog.
+*/
+#include <Arduino.h>
+#include "bluetooth.h"
+#include "receiver.h"
+#include "host_frames.h"
+#include "host_bench.h"
+
+#define RING_SIZE 64
+#define RING_MASK (RING_SIZE - 1)
+#define BACKLOG_FRAMES 20000
+#define ROUNDS 5
+
+static uint8_t ring[RING_SIZE];
+static uint16_t head = 0, tail = 0;
+static uint32_t sink = 0;
+
+// Stands in for the framer: consume everything buffered
+static void consume() {
+  while (tail != head) sink += ring[tail++ & RING_MASK];
+}
+
+static void drainPerByte() {
+  while (SerialBT.available() > 0) {
+    if ((uint16_t)(head - tail) == RING_SIZE) consume();
+
+    int b = SerialBT.read();
+    if (b < 0) break;
+    ring[head++ & RING_MASK] = (uint8_t)b;
+  }
+  consume();
+}
+
+static void drainBulk() {
+  int avail;
+  while ((avail = SerialBT.available()) > 0) {
+    if ((uint16_t)(head - tail) == RING_SIZE) consume();
+
+    uint16_t space = RING_SIZE - (uint16_t)(head - tail);
+    uint16_t want = avail < space ? (uint16_t)avail : space;
+
+    while (want > 0) {
+      uint16_t start = head & RING_MASK;
+      uint16_t chunk = RING_SIZE - start;
+      if (chunk > want) chunk = want;
+
+      size_t n = SerialBT.readBytes(&ring[start], chunk);
+      if (n == 0) break;
+      head += n;
+      want -= n;
+    }
+  }
+  consume();
+}
+
+static Bytes buildBacklog() {
+  Bytes out;
+  for (uint32_t i = 0; i < BACKLOG_FRAMES; i++)
+    hostAppend(out, hostStateFrame((uint16_t)i));
+  return out;
+}
+
+static void run(const char* name, void (*drain)(), const Bytes& backlog) {
+  uint64_t bestNs = UINT64_MAX;
+  uint32_t calls = 0;
+
+  for (int r = 0; r < ROUNDS; r++) {
+    SerialBT.hostFeed(backlog.data(), backlog.size());
+    SerialBT.readCalls = 0;
+
+    uint64_t t0 = benchNowNs();
+    drain();
+    uint64_t dt = benchNowNs() - t0;
+
+    if (dt < bestNs) bestNs = dt;
+    calls = SerialBT.readCalls;
+  }
+
+  printf("%-16s %8zu B  %8u read calls  %8.1f MB/s  %6.1f ns/byte\n",
+         name, backlog.size(), calls,
+         (double)backlog.size() * 1000.0 / (double)bestNs,
+         (double)bestNs / (double)backlog.size());
+}
+
+static void drainReceiver() {
+  handleBluetooth();
+}
+
+int main() {
+  Bytes backlog = buildBacklog();
+
+  receiverInit();
+
+  run("per-byte read()", drainPerByte, backlog);
+  run("bulk readBytes()", drainBulk, backlog);
+  run("handleBluetooth", drainReceiver, backlog);
+
+  benchKeep(sink);
+  return 0;
+}
@@ -0,0 +1,68 @@
+/*
+  bench_cobs.cpp
+  ------------------------------------------------------
+  cobsEncode() / cobsDecode() throughput on the packet
+  sizes the link actually carries (18-byte state frame,
+  plot packets up to LINK_TX_MAX) plus one long buffer,
+  for random and zero-heavy payloads. Every round trip is
+  checked against the input.
+*/
+#include <string.h>
+#include "cobs.h"
+#include "link.h"
+#include "host_bench.h"
+
+#define BENCH_BYTES (64u * 1024u * 1024u)   // per row
+
+struct Row {
+  size_t len;
+  uint8_t zeroPct;
+};
+
+static const Row rows[] = {
+  { 4,    0 }, { 18,   0 }, { 18,   30 }, { 64,   0 },
+  { 254,  0 }, { 255,  0 }, { LINK_TX_MAX, 0 }, { LINK_TX_MAX, 50 },
+  { 4096, 0 }, { 4096, 100 },
+};
+
+static uint8_t in[4096], enc[COBS_MAX_ENCODED(4096)], dec[4096];
+
+int main() {
+  BenchRng rng;
+  int failures = 0;
+
+  printf("%6s %5s %10s %10s %9s\n", "bytes", "zero%", "enc MB/s", "dec MB/s", "overhead");
+
+  for (const Row& r : rows) {
+    for (size_t i = 0; i < r.len; i++)
+      in[i] = rng.below(100) < r.zeroPct ? 0 : (uint8_t)(1 + rng.below(255));
+
+    uint32_t iters = BENCH_BYTES / r.len;
+    size_t encLen = 0, decLen = 0;
+
+    uint64_t t0 = benchNowNs();
+    for (uint32_t i = 0; i < iters; i++) {
+      encLen = cobsEncode(in, r.len, enc);
+      benchKeep(enc);
+    }
+    uint64_t t1 = benchNowNs();
+    for (uint32_t i = 0; i < iters; i++) {
+      decLen = cobsDecode(enc, encLen, dec);
+      benchKeep(dec);
+    }
+    uint64_t t2 = benchNowNs();
+
+    if (decLen != r.len || memcmp(in, dec, r.len) != 0 || memchr(enc, 0, encLen)) {
+      printf("round trip FAILED for %zu bytes\n", r.len);
+      failures++;
+    }
+
+    double bytes = (double)iters * (double)r.len;
+    printf("%6zu %5u %10.1f %10.1f %8zuB\n", r.len, r.zeroPct,
+           bytes * 1000.0 / (double)(t1 - t0),
+           bytes * 1000.0 / (double)(t2 - t1),
+           encLen - r.len);
+  }
+
+  return failures ? 1 : 0;
+}
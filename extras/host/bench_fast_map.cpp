@@ -0,0 +1,74 @@
+/*
+  bench_fast_map.cpp
+  ------------------------------------------------------
+  FastMap (fast_map.h) vs Arduino map() for the ranges
+  controlUpdate() uses: servo duty (3277–6553) and 8-bit
+  PWM (0–255).
+
+  Checks every input 0–4095 against map() first, then
+  times both over sequential and shuffled inputs. Built
+  twice by the Makefile: bench_fast_map (reciprocal,
+  the default) and bench_fast_map_lut (FAST_MAP_LUT).
+*/
+#include <Arduino.h>
+#include "fast_map.h"
+#include "host_bench.h"
+
+#define ROUNDS 4000
+
+static uint16_t seqIn[FAST_MAP_IN_MAX + 1];
+static uint16_t rndIn[FAST_MAP_IN_MAX + 1];
+
+template <uint16_t LO, uint16_t HI>
+static int verify() {
+  int bad = 0;
+  for (uint32_t x = 0; x <= FAST_MAP_IN_MAX; x++)
+    if (FastMap<LO, HI>::apply((uint16_t)x) != (uint16_t)map(x, 0, FAST_MAP_IN_MAX, LO, HI))
+      bad++;
+  return bad;
+}
+
+template <uint16_t LO, uint16_t HI>
+static void timeRange(const char* name, const uint16_t* in, const char* order) {
+  uint32_t sum = 0;
+
+  uint64_t t0 = benchNowNs();
+  for (int r = 0; r < ROUNDS; r++)
+    for (uint32_t i = 0; i <= FAST_MAP_IN_MAX; i++)
+      sum += (uint16_t)map(in[i], 0, FAST_MAP_IN_MAX, LO, HI);
+  uint64_t t1 = benchNowNs();
+  for (int r = 0; r < ROUNDS; r++)
+    for (uint32_t i = 0; i <= FAST_MAP_IN_MAX; i++)
+      sum += FastMap<LO, HI>::apply(in[i]);
+  uint64_t t2 = benchNowNs();
+
+  benchKeep(sum);
+
+  double calls = (double)ROUNDS * (FAST_MAP_IN_MAX + 1);
+  printf("%-10s %-10s  map() %6.2f ns  FastMap %6.2f ns  (%.1fx)\n",
+         name, order, (t1 - t0) / calls, (t2 - t1) / calls,
+         (double)(t1 - t0) / (double)(t2 - t1));
+}
+
+int main() {
+  BenchRng rng;
+
+  for (uint32_t i = 0; i <= FAST_MAP_IN_MAX; i++) seqIn[i] = rndIn[i] = (uint16_t)i;
+  for (uint32_t i = FAST_MAP_IN_MAX; i > 0; i--) {
+    uint32_t j = rng.below(i + 1);
+    uint16_t t = rndIn[i];
+    rndIn[i] = rndIn[j];
+    rndIn[j] = t;
+  }
+
+  int bad = verify<3277, 6553>() + verify<0, 255>();
+  printf("mode: %s, mismatches vs map(): %d\n",
+         FAST_MAP_MODE == FAST_MAP_LUT ? "LUT" : "reciprocal", bad);
+
+  timeRange<3277, 6553>("servo", seqIn, "sequential");
+  timeRange<3277, 6553>("servo", rndIn, "shuffled");
+  timeRange<0, 255>("pwm8", seqIn, "sequential");
+  timeRange<0, 255>("pwm8", rndIn, "shuffled");
+
+  return bad ? 1 : 0;
+}
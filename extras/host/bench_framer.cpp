@@ -0,0 +1,108 @@
+/*
+  bench_framer.cpp
+  ------------------------------------------------------
+  Receiver throughput and worst-case handleBluetooth()
+  time on clean, fragmented and noisy streams.
+
+  Each scenario pushes the same mix of state and event
+  frames through SerialBT in chunks, calling
+  handleBluetooth() once per chunk, and reports:
+    - MB/s through the framer (wall time inside
+      handleBluetooth() only)
+    - worst single call, in microseconds
+    - good / bad / resync counters from receiverGetStats()
+*/
+#include <Arduino.h>
+#include "bluetooth.h"
+#include "receiver.h"
+#include "event_queue.h"
+#include "link.h"
+#include "host_frames.h"
+#include "host_bench.h"
+
+#define BENCH_FRAMES 20000
+
+struct Scenario {
+  const char* name;
+  LinkFraming framing;
+  uint16_t minChunk, maxChunk;   // bytes fed per handleBluetooth()
+  uint8_t noisePct;              // chance of junk between frames
+  uint8_t corruptPct;            // chance a frame has one bad byte
+};
+
+static const Scenario scenarios[] = {
+  { "clean",      LINK_FRAMING_LEGACY, 256, 256, 0,  0 },
+  { "fragmented", LINK_FRAMING_LEGACY, 1,   7,   0,  0 },
+  { "noisy",      LINK_FRAMING_LEGACY, 16,  96,  30, 10 },
+  { "cobs clean", LINK_FRAMING_COBS,   256, 256, 0,  0 },
+  { "cobs noisy", LINK_FRAMING_COBS,   16,  96,  30, 10 },
+};
+
+static Bytes buildStream(const Scenario& s, BenchRng& rng) {
+  Bytes out;
+
+  for (uint32_t i = 0; i < BENCH_FRAMES; i++) {
+    if (rng.below(100) < s.noisePct) {
+      uint32_t junk = 1 + rng.below(12);
+      for (uint32_t j = 0; j < junk; j++) out.push_back((uint8_t)rng.next());
+    }
+
+    Bytes f = (i % 8 == 7) ? hostEventFrame((uint8_t)i) : hostStateFrame((uint16_t)(i & 4095));
+    if (rng.below(100) < s.corruptPct) f[2 + rng.below(f.size() - 2)] ^= 0x5A;
+
+    hostAppend(out, s.framing == LINK_FRAMING_COBS ? hostCobsFrame(f) : f);
+  }
+
+  return out;
+}
+
+static void runScenario(const Scenario& s, int8_t consumer) {
+  BenchRng rng;
+  Bytes stream = buildStream(s, rng);
+
+  receiverInit();
+  linkHandleFramingRequest(s.framing);
+  ReceiverStats before = receiverGetStats();
+
+  uint64_t totalNs = 0, worstNs = 0;
+  size_t pos = 0;
+  uint32_t calls = 0;
+
+  while (pos < stream.size()) {
+    size_t chunk = s.minChunk + rng.below(s.maxChunk - s.minChunk + 1);
+    if (chunk > stream.size() - pos) chunk = stream.size() - pos;
+
+    SerialBT.hostFeed(&stream[pos], chunk);
+    pos += chunk;
+    hostAdvanceUs(500);
+
+    uint64_t t0 = benchNowNs();
+    handleBluetooth();
+    uint64_t dt = benchNowNs() - t0;
+
+    totalNs += dt;
+    if (dt > worstNs) worstNs = dt;
+    calls++;
+
+    RcEvent e;
+    while (eventQueuePop(consumer, e)) {}
+  }
+
+  const ReceiverStats& st = receiverGetStats();
+  double mbps = totalNs ? (double)stream.size() * 1000.0 / (double)totalNs : 0.0;
+
+  printf("%-11s %8zu B %7u calls %8.1f MB/s  worst %7.2f us  good %6u bad %5u resync %5u\n",
+         s.name, stream.size(), calls, mbps, worstNs / 1000.0,
+         st.goodFrames - before.goodFrames,
+         st.badFrames - before.badFrames,
+         st.resyncs - before.resyncs);
+}
+
+int main() {
+  int8_t consumer = eventQueueSubscribe();
+
+  for (const Scenario& s : scenarios)
+    runScenario(s, consumer);
+
+  return 0;
+}
@@ -0,0 +1,86 @@
+/*
+  bench_mixer.cpp
+  ------------------------------------------------------
+  Per-tick cost of the mixer (mixer.cpp), and of the
+  curve + mixer stage controlUpdate() runs on every
+  state packet, for three matrices:
+    - identity (default)
+    - arcade-to-tank on the motor outputs (mixer.h)
+    - dense: every output weighted from every input
+
+  The target budget is single-digit microseconds per
+  tick on the ESP32; the host numbers here only show
+  that the cost is flat and small relative to that.
+*/
+#include <Arduino.h>
+#include "control.h"
+#include "curves.h"
+#include "mixer.h"
+#include "host_bench.h"
+
+#define TICKS 2000000
+
+static void arcadeToTank() {
+  mixerSetWeight(CH_MOTOR_L, CH_MOTOR_L,  MIX_ONE);
+  mixerSetWeight(CH_MOTOR_L, CH_STEERING, MIX_ONE);
+  mixerSetWeight(CH_MOTOR_R, CH_MOTOR_L,  MIX_ONE);
+  mixerSetWeight(CH_MOTOR_R, CH_MOTOR_R,  0);
+  mixerSetWeight(CH_MOTOR_R, CH_STEERING, -MIX_ONE);
+}
+
+static void dense() {
+  for (uint8_t o = 0; o < CH_COUNT; o++)
+    for (uint8_t i = 0; i < CH_COUNT; i++)
+      mixerSetWeight(o, i, (int16_t)((o == i ? MIX_ONE : MIX_ONE / 8) - (int16_t)(i * 512)));
+}
+
+static void run(const char* name, bool withCurves) {
+  BenchRng rng;
+  uint16_t in[64][CH_COUNT];
+
+  for (auto& row : in)
+    for (uint16_t& v : row) v = (uint16_t)rng.below(4096);
+
+  uint16_t ch[CH_COUNT];
+  uint32_t sum = 0;
+
+  uint64_t t0 = benchNowNs();
+  for (uint32_t t = 0; t < TICKS; t++) {
+    const uint16_t* src = in[t & 63];
+    for (uint8_t i = 0; i < CH_COUNT; i++) ch[i] = src[i];
+
+    if (withCurves)
+      for (uint8_t i = 0; i < CH_COUNT; i++) ch[i] = curveApply(i, ch[i]);
+
+    mixerApply(ch);
+    sum += ch[CH_MOTOR_R];
+  }
+  uint64_t dt = benchNowNs() - t0;
+
+  benchKeep(sum);
+  printf("%-9s %-15s %7.1f ns/tick\n", name, withCurves ? "curves + mixer" : "mixer", (double)dt / TICKS);
+}
+
+int main() {
+  curvesInit();
+  for (uint8_t i = 0; i < CH_COUNT; i++) {
+    CurveParams p = curveGetParams(i);
+    p.expoPct = 40;
+    p.deadband = 40;
+    curveSetParams(i, p);
+  }
+
+  mixerInit();
+  run("identity", false);
+  run("identity", true);
+
+  arcadeToTank();
+  run("tank", false);
+  run("tank", true);
+
+  dense();
+  run("dense", false);
+  run("dense", true);
+
+  return 0;
+}
@@ -0,0 +1,38 @@
+/*
+  host_bench.h
+  ------------------------------------------------------
+  Wall-clock helpers for the host benches. Numbers are
+  desktop numbers: compare variants against each other,
+  not against the ESP32.
+*/
+#ifndef HOST_BENCH_H
+#define HOST_BENCH_H
+
+#include <chrono>
+#include <stdint.h>
+#include <stdio.h>
+
+inline uint64_t benchNowNs() {
+  return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Keeps the optimizer from discarding a benchmarked result
+template <typename T>
+inline void benchKeep(const T& v) {
+  asm volatile("" : : "g"(&v) : "memory");
+}
+
+// Simple deterministic PRNG so runs are comparable
+struct BenchRng {
+  uint32_t s = 0x12345678;
+  uint32_t next() {
+    s ^= s << 13;
+    s ^= s >> 17;
+    s ^= s << 5;
+    return s;
+  }
+  uint32_t below(uint32_t n) { return next() % n; }
+};
+
+#endif
@@ -0,0 +1,54 @@
+/*
+  host_frames.h
+  ------------------------------------------------------
+  Builders for inbound frames, shared by the host tests
+  and benches. Checksums follow packets.h (additive sum
+  from byte 2 up to the checksum byte).
+*/
+#ifndef HOST_FRAMES_H
+#define HOST_FRAMES_H
+
+#include <vector>
+#include "packets.h"
+#include "cobs.h"
+
+typedef std::vector<uint8_t> Bytes;
+
+inline uint8_t hostChecksum(const uint8_t* frame, size_t csIndex) {
+  uint8_t c = 0;
+  for (size_t i = 2; i < csIndex; i++) c += frame[i];
+  return c;
+}
+
+inline Bytes hostStateFrame(uint16_t leftStickX, byte switches = 0) {
+  RcPacket p = {};
+  p.startByte1 = 0xAA;
+  p.startByte2 = 0x55;
+  p.leftStickX = leftStickX;
+  p.leftStickY = p.rightStickX = p.rightStickY = 2048;
+  p.switches = switches;
+  p.endByte1 = 0x0D;
+  p.endByte2 = 0x0A;
+
+  const uint8_t* b = (const uint8_t*)&p;
+  p.checksum = hostChecksum(b, offsetof(RcPacket, checksum));
+  return Bytes(b, b + sizeof(p));
+}
+
+inline Bytes hostEventFrame(uint8_t eventId) {
+  return Bytes{ 0xBB, 0x66, eventId, eventId };
+}
+
+inline Bytes hostCobsFrame(const Bytes& frame) {
+  Bytes out(COBS_MAX_ENCODED(frame.size()) + 1);
+  size_t n = cobsEncode(frame.data(), frame.size(), out.data());
+  out.resize(n);
+  out.push_back(0x00);
+  return out;
+}
+
+inline void hostAppend(Bytes& dst, const Bytes& src) {
+  dst.insert(dst.end(), src.begin(), src.end());
+}
+
+#endif
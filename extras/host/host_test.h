@@ -0,0 +1,37 @@
+/*
+  host_test.h
+  ------------------------------------------------------
+  Minimal assertions for the host tests. A failed check
+  prints file:line and the test exits non-zero.
+*/
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#include <stdio.h>
+
+static int hostTestFailures = 0;
+
+#define CHECK(cond)                                                   \
+  do {                                                                \
+    if (!(cond)) {                                                    \
+      printf("%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+      hostTestFailures++;                                             \
+    }                                                                 \
+  } while (0)
+
+#define CHECK_EQ(a, b)                                                \
+  do {                                                                \
+    long long va_ = (long long)(a), vb_ = (long long)(b);             \
+    if (va_ != vb_) {                                                 \
+      printf("%s:%d: CHECK_EQ failed: %s == %s (%lld vs %lld)\n",     \
+             __FILE__, __LINE__, #a, #b, va_, vb_);                   \
+      hostTestFailures++;                                             \
+    }                                                                 \
+  } while (0)
+
+inline int hostTestReport(const char* name) {
+  printf("%s: %s\n", name, hostTestFailures ? "FAILED" : "ok");
+  return hostTestFailures ? 1 : 0;
+}
+
+#endif
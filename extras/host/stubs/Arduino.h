@@ -0,0 +1,149 @@
+/*
+  Arduino.h (host stand-in)
+  ------------------------------------------------------
+  Just enough of the Arduino-ESP32 core for the portable
+  modules to build and run under a desktop g++.
+
+  Purpose:
+  --------
+  • millis() / micros() read a virtual clock that tests
+    and benches move with hostAdvanceUs(), which also
+    fires due esp_timer callbacks (see esp_timer.h).
+  • digitalWrite() records pin levels in hostPinLevel[]
+    and calls hostOnDigitalWrite (if set); tests drive
+    inputs with hostDriveInput(), which runs the ISR
+    attached to the pin on a matching edge.
+  • xTaskCreatePinnedToCore() starts a detached
+    std::thread and vTaskDelay() sleeps 1 ms per tick,
+    so task-mode code runs for real; semaphores and task
+    notifications block, critical sections are spinlocks.
+
+  Not part of the sketch: Arduino only compiles the
+  sketch root and src/, so nothing under extras/ ships.
+*/
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <atomic>
+
+typedef uint8_t byte;
+
+#define HIGH 1
+#define LOW  0
+#define INPUT        0
+#define OUTPUT       1
+#define INPUT_PULLUP 2
+#define CHANGE  1
+#define FALLING 2
+#define RISING  3
+#define IRAM_ATTR
+
+/* =====================================================
+   VIRTUAL CLOCK
+   ===================================================== */
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+
+uint64_t hostMicros();
+void hostSetMicros(uint64_t us);
+void hostAdvanceUs(uint64_t us);
+
+/* =====================================================
+   GPIO
+   ===================================================== */
+
+#define HOST_PIN_COUNT 64
+
+extern uint8_t hostPinLevel[HOST_PIN_COUNT];
+extern void (*hostOnDigitalWrite)(uint8_t pin, uint8_t level);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t level);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+bool ledcAttach(uint8_t pin, uint32_t freq, uint8_t bits);
+bool ledcWrite(uint8_t pin, uint32_t duty);
+int digitalPinToInterrupt(int pin);
+void attachInterrupt(int irq, void (*isr)(), int mode);
+
+void hostDriveInput(uint8_t pin, uint8_t level);
+
+/* =====================================================
+   MATH
+   ===================================================== */
+
+// Out of line, as in the core, so benches compare against
+// a real divide rather than one folded at compile time
+long map(long x, long inMin, long inMax, long outMin, long outMax);
+
+template <typename T>
+inline T constrain(T x, T lo, T hi) {
+  return x < lo ? lo : (x > hi ? hi : x);
+}
+
+/* =====================================================
+   SERIAL (debug output is discarded)
+   ===================================================== */
+
+struct HardwareSerial {
+  void begin(unsigned long) {}
+  int available() { return 0; }
+  int read() { return -1; }
+  size_t write(const uint8_t*, size_t n) { return n; }
+  int printf(const char*, ...) { return 0; }
+  void print(const char*) {}
+  void println(const char* = "") {}
+};
+
+extern HardwareSerial Serial;
+
+/* =====================================================
+   FREERTOS
+   ===================================================== */
+
+// Spinlock, so modules that start tasks can be run with
+// real threads on the host
+typedef struct { std::atomic_flag flag; } portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED { ATOMIC_FLAG_INIT }
+
+inline void hostMuxEnter(portMUX_TYPE* m) {
+  while (m->flag.test_and_set(std::memory_order_acquire)) {}
+}
+
+inline void hostMuxExit(portMUX_TYPE* m) {
+  m->flag.clear(std::memory_order_release);
+}
+
+#define portENTER_CRITICAL(m)     hostMuxEnter(m)
+#define portEXIT_CRITICAL(m)      hostMuxExit(m)
+#define portENTER_CRITICAL_ISR(m) hostMuxEnter(m)
+#define portEXIT_CRITICAL_ISR(m)  hostMuxExit(m)
+
+typedef void* TaskHandle_t;
+#define pdTRUE  1
+#define pdFALSE 0
+#define pdPASS  1
+#define portMAX_DELAY 0xFFFFFFFFu
+
+typedef struct HostMutex* SemaphoreHandle_t;
+
+SemaphoreHandle_t xSemaphoreCreateMutex();
+SemaphoreHandle_t xSemaphoreCreateBinary();
+int xSemaphoreTake(SemaphoreHandle_t sem, uint32_t ticks);
+int xSemaphoreGive(SemaphoreHandle_t sem);
+
+int xTaskCreatePinnedToCore(void (*fn)(void*), const char* name, uint32_t stack,
+                            void* arg, int prio, TaskHandle_t* handle, int core);
+void vTaskDelay(uint32_t ticks);
+void taskYIELD();
+uint32_t ulTaskNotifyTake(int clearOnExit, uint32_t ticks);
+void xTaskNotifyGive(TaskHandle_t task);
+
+#endif
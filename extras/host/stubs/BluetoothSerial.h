@@ -0,0 +1,42 @@
+/*
+  BluetoothSerial.h (host stand-in)
+  ------------------------------------------------------
+  In-memory SPP link. Tests push inbound bytes with
+  hostFeed(); writes are counted and dropped.
+
+  Every read()/readBytes()/available() call takes a lock,
+  like the real driver's RX queue, so benches see the
+  per-call cost that bulk reads are meant to avoid.
+*/
+#ifndef HOST_BLUETOOTH_SERIAL_H
+#define HOST_BLUETOOTH_SERIAL_H
+
+#include <Arduino.h>
+#include <deque>
+#include <mutex>
+
+class BluetoothSerial {
+public:
+  bool begin(const char*) { return true; }
+  bool hasClient() { return connected; }
+
+  int available();
+  int read();
+  size_t readBytes(uint8_t* buf, size_t len);
+  size_t write(const uint8_t* buf, size_t len);
+  size_t write(uint8_t b) { return write(&b, 1); }
+
+  // Host side
+  void hostFeed(const uint8_t* buf, size_t len);
+  void hostClear();
+
+  bool connected = true;
+  uint32_t readCalls = 0;    // read() + readBytes() calls
+  uint32_t bytesWritten = 0;
+
+private:
+  std::mutex lock;
+  std::deque<uint8_t> rx;
+};
+
+#endif
@@ -0,0 +1,55 @@
+/*
+  Wire.h (host stand-in)
+  ------------------------------------------------------
+  I2C master routed to in-memory devices. Tests attach a
+  HostI2cDevice at an address with hostI2cAttach(); an
+  address with nothing attached NACKs, as an unfitted
+  chip would.
+
+  Transactions run synchronously and take no time on the
+  virtual clock.
+*/
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+#include <Arduino.h>
+
+class HostI2cDevice {
+public:
+  virtual ~HostI2cDevice() {}
+
+  // Bytes of one write transaction (register pointer first)
+  virtual void i2cWrite(const uint8_t* data, uint8_t n) = 0;
+
+  // One read transaction of n bytes
+  virtual void i2cRead(uint8_t* out, uint8_t n) = 0;
+};
+
+void hostI2cAttach(uint8_t addr, HostI2cDevice* dev);
+
+class TwoWire {
+public:
+  bool begin(int sda = -1, int scl = -1, uint32_t freq = 0) { return true; }
+  void setClock(uint32_t) {}
+
+  void beginTransmission(uint8_t addr);
+  size_t write(const uint8_t* data, size_t n);
+  size_t write(uint8_t b) { return write(&b, 1); }
+  uint8_t endTransmission(bool sendStop = true);
+
+  uint8_t requestFrom(uint8_t addr, uint8_t n, bool sendStop = true);
+  int available() { return rxLen - rxPos; }
+  int read() { return rxPos < rxLen ? rxBuf[rxPos++] : -1; }
+
+private:
+  uint8_t txAddr = 0;
+  uint8_t txLen = 0;
+  uint8_t txBuf[32];
+  uint8_t rxLen = 0;
+  uint8_t rxPos = 0;
+  uint8_t rxBuf[32];
+};
+
+extern TwoWire Wire;
+
+#endif
@@ -0,0 +1,32 @@
+/*
+  esp_timer.h (host stand-in)
+  ------------------------------------------------------
+  esp_timer_get_time() reads the virtual clock. Timers
+  fire from hostAdvanceUs() on the thread that calls it,
+  at their exact deadline on the virtual clock.
+*/
+#ifndef HOST_ESP_TIMER_H
+#define HOST_ESP_TIMER_H
+
+#include <stdint.h>
+
+typedef void* esp_timer_handle_t;
+typedef int esp_err_t;
+
+enum esp_timer_dispatch_t { ESP_TIMER_TASK, ESP_TIMER_ISR };
+
+struct esp_timer_create_args_t {
+  void (*callback)(void* arg);
+  void* arg;
+  esp_timer_dispatch_t dispatch_method;
+  const char* name;
+  bool skip_unhandled_events;
+};
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t* args, esp_timer_handle_t* out);
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeoutUs);
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t periodUs);
+esp_err_t esp_timer_stop(esp_timer_handle_t timer);
+int64_t esp_timer_get_time();
+
+#endif
@@ -0,0 +1,330 @@
+/*
+  host_arduino.cpp
+  ------------------------------------------------------
+  Definitions for the host stand-ins in this directory.
+  See Arduino.h.
+*/
+#include <Arduino.h>
+#include <BluetoothSerial.h>
+#include <esp_timer.h>
+#include <Wire.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+HardwareSerial Serial;
+BluetoothSerial SerialBT;   // bluetooth.cpp is not linked on the host
+TwoWire Wire;
+
+/* =====================================================
+   VIRTUAL CLOCK
+   ===================================================== */
+
+static std::atomic<uint64_t> nowUs(0);   // read from host task threads too
+
+struct HostTimer {
+  esp_timer_create_args_t args;
+  bool armed;
+  uint64_t deadline;
+  uint64_t period;      // 0 = one-shot
+};
+
+static std::vector<HostTimer*> timers;
+
+uint64_t hostMicros() { return nowUs; }
+void hostSetMicros(uint64_t us) { nowUs = us; }
+
+// Moves the clock to each due timer deadline in turn and
+// runs its callback there, then to now + us
+void hostAdvanceUs(uint64_t us) {
+  uint64_t end = nowUs + us;
+
+  for (;;) {
+    HostTimer* next = nullptr;
+    for (HostTimer* t : timers)
+      if (t->armed && t->deadline <= end && (!next || t->deadline < next->deadline))
+        next = t;
+
+    if (!next) break;
+
+    if (next->deadline > nowUs) nowUs = next->deadline;
+    if (next->period) next->deadline += next->period;
+    else next->armed = false;
+
+    next->args.callback(next->args.arg);
+  }
+
+  nowUs = end;
+}
+
+uint32_t millis() { return (uint32_t)(nowUs / 1000); }
+uint32_t micros() { return (uint32_t)nowUs; }
+void delay(uint32_t ms) { hostAdvanceUs((uint64_t)ms * 1000); }
+
+/* =====================================================
+   MATH
+   ===================================================== */
+
+long map(long x, long inMin, long inMax, long outMin, long outMax) {
+  return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+/* =====================================================
+   GPIO
+   ===================================================== */
+
+uint8_t hostPinLevel[HOST_PIN_COUNT];
+void (*hostOnDigitalWrite)(uint8_t pin, uint8_t level) = nullptr;
+
+void pinMode(uint8_t, uint8_t) {}
+
+void digitalWrite(uint8_t pin, uint8_t level) {
+  if (pin < HOST_PIN_COUNT) hostPinLevel[pin] = level;
+  if (hostOnDigitalWrite) hostOnDigitalWrite(pin, level);
+}
+
+int digitalRead(uint8_t pin) {
+  return pin < HOST_PIN_COUNT ? hostPinLevel[pin] : LOW;
+}
+
+int analogRead(uint8_t) { return 0; }
+bool ledcAttach(uint8_t, uint32_t, uint8_t) { return true; }
+bool ledcWrite(uint8_t, uint32_t) { return true; }
+int digitalPinToInterrupt(int pin) { return pin; }
+
+struct HostIsr {
+  void (*fn)();
+  int mode;
+};
+
+static HostIsr isrs[HOST_PIN_COUNT];
+
+void attachInterrupt(int irq, void (*isr)(), int mode) {
+  if (irq >= 0 && irq < HOST_PIN_COUNT) isrs[irq] = { isr, mode };
+}
+
+// Runs the pin's ISR inline when the edge matches its mode
+void hostDriveInput(uint8_t pin, uint8_t level) {
+  if (pin >= HOST_PIN_COUNT) return;
+
+  uint8_t was = hostPinLevel[pin];
+  hostPinLevel[pin] = level;
+
+  const HostIsr& i = isrs[pin];
+  if (!i.fn || was == level) return;
+
+  if (i.mode == CHANGE || (i.mode == FALLING && level == LOW) ||
+      (i.mode == RISING && level == HIGH))
+    i.fn();
+}
+
+/* =====================================================
+   FREERTOS
+   ===================================================== */
+
+struct HostMutex {
+  std::mutex m;
+  std::condition_variable cv;
+  bool available;
+};
+
+SemaphoreHandle_t xSemaphoreCreateMutex() { return new HostMutex{ {}, {}, true }; }
+SemaphoreHandle_t xSemaphoreCreateBinary() { return new HostMutex{ {}, {}, false }; }
+
+// ticks are 1 ms, as with the default tick rate
+int xSemaphoreTake(SemaphoreHandle_t sem, uint32_t ticks) {
+  std::unique_lock<std::mutex> g(sem->m);
+  auto ready = [sem] { return sem->available; };
+
+  if (ticks == portMAX_DELAY) sem->cv.wait(g, ready);
+  else if (!sem->cv.wait_for(g, std::chrono::milliseconds(ticks), ready)) return pdFALSE;
+
+  sem->available = false;
+  return pdTRUE;
+}
+
+int xSemaphoreGive(SemaphoreHandle_t sem) {
+  std::lock_guard<std::mutex> g(sem->m);
+  bool was = sem->available;
+  sem->available = true;
+  sem->cv.notify_one();
+  return was ? pdFALSE : pdTRUE;
+}
+
+// Notification value of each started task
+struct HostTask {
+  std::mutex m;
+  std::condition_variable cv;
+  uint32_t notified = 0;
+};
+
+static thread_local HostTask* currentTask = nullptr;
+
+int xTaskCreatePinnedToCore(void (*fn)(void*), const char*, uint32_t,
+                            void* arg, int, TaskHandle_t* handle, int) {
+  HostTask* task = new HostTask;
+  if (handle) *handle = task;
+
+  std::thread t([task, fn, arg] {
+    currentTask = task;
+    fn(arg);
+  });
+  t.detach();
+  return pdPASS;
+}
+
+void vTaskDelay(uint32_t ticks) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+}
+
+void taskYIELD() { std::this_thread::yield(); }
+uint32_t ulTaskNotifyTake(int clearOnExit, uint32_t ticks) {
+  HostTask* task = currentTask;
+  if (!task) return 0;   // not a task started by the host
+
+  std::unique_lock<std::mutex> g(task->m);
+  auto ready = [task] { return task->notified != 0; };
+
+  if (ticks == portMAX_DELAY) task->cv.wait(g, ready);
+  else if (!task->cv.wait_for(g, std::chrono::milliseconds(ticks), ready)) return 0;
+
+  uint32_t v = task->notified;
+  task->notified = clearOnExit ? 0 : v - 1;
+  return v;
+}
+
+void xTaskNotifyGive(TaskHandle_t handle) {
+  HostTask* task = (HostTask*)handle;
+  if (!task) return;
+
+  std::lock_guard<std::mutex> g(task->m);
+  task->notified++;
+  task->cv.notify_one();
+}
+
+/* =====================================================
+   ESP_TIMER (fired by hostAdvanceUs)
+   ===================================================== */
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t* args, esp_timer_handle_t* out) {
+  HostTimer* t = new HostTimer{ *args, false, 0, 0 };
+  timers.push_back(t);
+  *out = t;
+  return 0;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t h, uint64_t timeoutUs) {
+  HostTimer* t = (HostTimer*)h;
+  t->armed = true;
+  t->deadline = nowUs + timeoutUs;
+  t->period = 0;
+  return 0;
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t h, uint64_t periodUs) {
+  HostTimer* t = (HostTimer*)h;
+  t->armed = true;
+  t->deadline = nowUs + periodUs;
+  t->period = periodUs;
+  return 0;
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t h) {
+  ((HostTimer*)h)->armed = false;
+  return 0;
+}
+
+int64_t esp_timer_get_time() { return (int64_t)nowUs.load(); }
+
+/* =====================================================
+   WIRE (devices attached by the test)
+   ===================================================== */
+
+static HostI2cDevice* i2cDevices[128];
+
+void hostI2cAttach(uint8_t addr, HostI2cDevice* dev) {
+  if (addr < 128) i2cDevices[addr] = dev;
+}
+
+void TwoWire::beginTransmission(uint8_t addr) {
+  txAddr = addr;
+  txLen = 0;
+}
+
+size_t TwoWire::write(const uint8_t* data, size_t n) {
+  size_t room = sizeof(txBuf) - txLen;
+  if (n > room) n = room;
+  memcpy(&txBuf[txLen], data, n);
+  txLen += (uint8_t)n;
+  return n;
+}
+
+// 0 = ACK, 2 = address NACK, as in the core
+uint8_t TwoWire::endTransmission(bool) {
+  HostI2cDevice* dev = txAddr < 128 ? i2cDevices[txAddr] : nullptr;
+  if (!dev) return 2;
+
+  dev->i2cWrite(txBuf, txLen);
+  return 0;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t addr, uint8_t n, bool) {
+  HostI2cDevice* dev = addr < 128 ? i2cDevices[addr] : nullptr;
+
+  rxPos = 0;
+  rxLen = 0;
+  if (!dev) return 0;
+
+  if (n > sizeof(rxBuf)) n = sizeof(rxBuf);
+  dev->i2cRead(rxBuf, n);
+  rxLen = n;
+  return n;
+}
+
+/* =====================================================
+   BLUETOOTH SERIAL
+   ===================================================== */
+
+int BluetoothSerial::available() {
+  std::lock_guard<std::mutex> g(lock);
+  return (int)rx.size();
+}
+
+int BluetoothSerial::read() {
+  std::lock_guard<std::mutex> g(lock);
+  readCalls++;
+  if (rx.empty()) return -1;
+
+  int b = rx.front();
+  rx.pop_front();
+  return b;
+}
+
+size_t BluetoothSerial::readBytes(uint8_t* buf, size_t len) {
+  std::lock_guard<std::mutex> g(lock);
+  readCalls++;
+
+  size_t n = len < rx.size() ? len : rx.size();
+  for (size_t i = 0; i < n; i++) {
+    buf[i] = rx.front();
+    rx.pop_front();
+  }
+  return n;
+}
+
+size_t BluetoothSerial::write(const uint8_t*, size_t len) {
+  bytesWritten += len;
+  return len;
+}
+
+void BluetoothSerial::hostFeed(const uint8_t* buf, size_t len) {
+  std::lock_guard<std::mutex> g(lock);
+  rx.insert(rx.end(), buf, buf + len);
+}
+
+void BluetoothSerial::hostClear() {
+  std::lock_guard<std::mutex> g(lock);
+  rx.clear();
+}
@@ -0,0 +1,18 @@
+/*
+  host_control.cpp
+  ------------------------------------------------------
+  Stand-ins for control.cpp entry points that receiver
+  handlers reach. control.cpp itself needs the output
+  hardware, so host programs link these instead.
+*/
+#include "control.h"
+
+static EventAction actions[256];
+
+void controlSetEventAction(byte eventId, const EventAction& action) {
+  actions[eventId] = action;
+}
+
+const EventAction& controlGetEventAction(byte eventId) {
+  return actions[eventId];
+}
@@ -0,0 +1,184 @@
+/*
+  test_attitude.cpp
+  ------------------------------------------------------
+  Fixed-point complementary filter (attitude.cpp) fed
+  synthetic IMU samples. attitude.cpp is included rather
+  than linked so its integer helpers can be checked
+  directly; imu.cpp is replaced by a stand-in that just
+  records the consumer.
+
+  Covers:
+    - iatan2 error vs atan2f (< 0.25°, as documented)
+      over every 0.01° step at three radii and random
+      int16 pairs
+    - isqrt is floor(sqrt) over the range the filter uses
+    - a static tilt settles on the accelerometer angles
+    - gyro roll and yaw at 45 °/s track across the ±180°
+      wrap
+*/
+#include <Arduino.h>
+#include <math.h>
+#include "attitude.cpp"
+#include "host_bench.h"
+#include "host_test.h"
+
+#define ACC_1G 16384   // ±2 g full scale
+
+/* ---------- IMU STAND-IN ---------- */
+
+static ImuConsumerFn consumer = nullptr;
+
+bool imuPresent() { return true; }
+
+bool imuAddConsumer(ImuConsumerFn fn) {
+  consumer = fn;
+  return true;
+}
+
+/* ---------- HELPERS ---------- */
+
+static double degToCdeg(double rad) {
+  return rad * 18000.0 / M_PI;
+}
+
+// Centidegree difference folded into (−18000, 18000]
+static double angleDiff(double a, double b) {
+  double d = fmod(a - b, 36000.0);
+  if (d > 18000.0) d -= 36000.0;
+  if (d <= -18000.0) d += 36000.0;
+  return d;
+}
+
+static ImuSample tiltSample(double rollCdeg, double pitchCdeg, int16_t gx, int16_t gz) {
+  double r = rollCdeg * M_PI / 18000.0;
+  double p = pitchCdeg * M_PI / 18000.0;
+
+  ImuSample s;
+  s.ax = (int16_t)lround(-sin(p) * ACC_1G);
+  s.ay = (int16_t)lround(cos(p) * sin(r) * ACC_1G);
+  s.az = (int16_t)lround(cos(p) * cos(r) * ACC_1G);
+  s.gx = gx;
+  s.gy = 0;
+  s.gz = gz;
+  return s;
+}
+
+/* ---------- TESTS ---------- */
+
+static void testAtan2() {
+  static const double radii[] = { 200, ACC_1G, 32000 };
+  double maxErr = 0;
+
+  for (double r : radii) {
+    for (int32_t k = -18000; k < 18000; k++) {
+      int32_t y = (int32_t)lround(r * sin(k * M_PI / 18000.0));
+      int32_t x = (int32_t)lround(r * cos(k * M_PI / 18000.0));
+
+      double err = fabs(angleDiff(iatan2(y, x), degToCdeg(atan2f((float)y, (float)x))));
+      if (err > maxErr) maxErr = err;
+    }
+  }
+
+  BenchRng rng;
+  for (uint32_t i = 0; i < 1000000; i++) {
+    int32_t y = (int32_t)rng.below(65536) - 32768;
+    int32_t x = (int32_t)rng.below(65536) - 32768;
+    if (x == 0 && y == 0) continue;
+
+    double err = fabs(angleDiff(iatan2(y, x), degToCdeg(atan2f((float)y, (float)x))));
+    if (err > maxErr) maxErr = err;
+  }
+
+  CHECK(maxErr < 25.0);
+  CHECK_EQ(iatan2(0, 0), 0);
+  CHECK_EQ(iatan2(0, -5), 18000);   // +180°, not −180°
+
+  printf("  iatan2 max error %.1f cdeg\n", maxErr);
+}
+
+static void testIsqrt() {
+  uint32_t bad = 0;
+
+  for (uint32_t v = 0; v < 1000000; v++) {
+    uint64_t r = isqrt(v);
+    if (r * r > v || (r + 1) * (r + 1) <= v) bad++;
+  }
+
+  // ay² + az² of int16 values stays below 2^31
+  BenchRng rng;
+  for (uint32_t i = 0; i < 1000000; i++) {
+    uint32_t v = (rng.below(32769) * rng.below(32769)) * 2u;
+    uint64_t r = isqrt(v);
+    if (r * r > v || (r + 1) * (r + 1) <= v) bad++;
+  }
+
+  CHECK_EQ(bad, 0);
+}
+
+static void testStaticTilt() {
+  primed = false;
+
+  // 3 s at 200 Hz, ~5 filter time constants
+  for (uint32_t i = 0; i < 3 * IMU_RATE_HZ; i++)
+    consumer(tiltSample(3000, -2000, 0, 0));
+
+  Attitude a;
+  attitudeGet(a);
+
+  CHECK(a.valid);
+  CHECK(abs(a.rollCdeg - 3000) <= 25);
+  CHECK(abs(a.pitchCdeg - (-2000)) <= 25);
+  CHECK_EQ(a.yawCdeg, 0);
+}
+
+static void testGyroAcrossWrap() {
+  const int16_t rate = 2948;   // ~45 °/s at 65.5 LSB per °/s
+  const double stepCdeg = rate * 1000.0 / (IMU_GYRO_LSB_PER_DPS_X10 * (double)IMU_RATE_HZ);
+
+  primed = false;
+
+  double truth = 17000;
+  consumer(tiltSample(truth, 0, 0, 0));   // primes at 170°
+
+  double maxRollErr = 0, maxYawErr = 0;
+  bool rollWrapped = false, yawWrapped = false;
+  int16_t prevRoll = 17000, prevYaw = 0;
+
+  // 5 s: roll passes +180° after ~0.2 s, yaw after ~4 s
+  for (uint32_t i = 1; i <= 5 * IMU_RATE_HZ; i++) {
+    truth += stepCdeg;
+    consumer(tiltSample(truth, 0, rate, rate));
+
+    Attitude a;
+    attitudeGet(a);
+
+    double rollErr = fabs(angleDiff(a.rollCdeg, truth));
+    double yawErr = fabs(angleDiff(a.yawCdeg, stepCdeg * i));
+    if (rollErr > maxRollErr) maxRollErr = rollErr;
+    if (yawErr > maxYawErr) maxYawErr = yawErr;
+
+    if (prevRoll > 17000 && a.rollCdeg < -17000) rollWrapped = true;
+    if (prevYaw > 17000 && a.yawCdeg < -17000) yawWrapped = true;
+    prevRoll = a.rollCdeg;
+    prevYaw = a.yawCdeg;
+  }
+
+  CHECK(rollWrapped);
+  CHECK(yawWrapped);
+  CHECK(maxRollErr < 25.0);
+  CHECK(maxYawErr < 5.0);
+
+  printf("  45 deg/s: roll max error %.1f cdeg, yaw %.1f cdeg\n", maxRollErr, maxYawErr);
+}
+
+int main() {
+  attitudeInit();
+  CHECK(consumer != nullptr);
+
+  testAtan2();
+  testIsqrt();
+  testStaticTilt();
+  testGyroAcrossWrap();
+
+  return hostTestReport("test_attitude");
+}
@@ -0,0 +1,65 @@
+/*
+  test_failsafe.cpp
+  ------------------------------------------------------
+  Link-loss failsafe (failsafe.cpp) on the virtual clock.
+
+  Covers:
+    - no frame yet -> safe values
+    - trips after FAILSAFE_TIMEOUT_MS without a frame
+    - stays tripped past the 32-bit micros() wrap
+      (~71.6 min of silence), where the raw gap reads
+      small again
+    - the next frame hands control back
+*/
+#include <Arduino.h>
+#include "failsafe.h"
+#include "host_test.h"
+
+static uint16_t live[CH_COUNT] = { 4095, 4095, 4095, 4095, 4095, 4095 };
+
+static bool apply(uint16_t ch[CH_COUNT]) {
+  byte sw = 0xFF;
+  memcpy(ch, live, sizeof(live));
+  return failsafeApply(ch, sw);
+}
+
+int main() {
+  uint16_t ch[CH_COUNT];
+
+  hostSetMicros(1000000);
+  CHECK(apply(ch));   // never fed
+
+  failsafeFeed();
+  CHECK(!apply(ch));
+  CHECK_EQ(ch[CH_STEERING], 4095);
+
+  hostAdvanceUs((uint64_t)FAILSAFE_TIMEOUT_MS * 1000 - 1);
+  CHECK(!apply(ch));
+
+  hostAdvanceUs(1);
+  CHECK(apply(ch));
+  CHECK_EQ(ch[CH_STEERING], 2048);
+  uint32_t trips = failsafeGetStats().trips;
+
+  // Link stays down; the main loop keeps running every 10 ms
+  // until the micros() gap has wrapped around
+  uint64_t wrapUs = 0x100000000ull;
+  uint32_t released = 0;
+
+  for (uint64_t t = 0; t < wrapUs + 200000; t += 10000) {
+    hostAdvanceUs(10000);
+    if (!apply(ch)) released++;
+  }
+
+  CHECK_EQ(released, 0);
+  CHECK_EQ(ch[CH_STEERING], 2048);
+  CHECK_EQ(ch[CH_MOTOR_L], 0);
+  CHECK_EQ(failsafeGetStats().trips, trips);
+  CHECK(failsafeGetStats().active);
+
+  failsafeFeed();
+  CHECK(!apply(ch));
+  CHECK(!failsafeGetStats().active);
+
+  return hostTestReport("test_failsafe");
+}
@@ -0,0 +1,237 @@
+/*
+  test_mcp_int.cpp
+  ------------------------------------------------------
+  MCP23017 interrupt-on-change path (mcp_io.cpp) against a
+  register model of the chip behind the Wire stand-in.
+  The model drives the shared INT line on PIN_MCP_INT,
+  which runs the ISR mcpInit() attached. The bus runs
+  inline (I2C_USE_TASK=0), so a read queued by one
+  mcpSync() is taken by the next.
+
+  Covers:
+    - init programs IOCON (MIRROR, ODR) and GPINTEN
+    - a quiet line never reads INTCAP
+    - an edge reads INTCAP once and releases the line;
+      the captured state reaches mcpReadDigitalInputs()
+      and mcpTakeInputChange()
+    - a pulse that is over before the read is still seen,
+      then the level it settled at one tick later
+    - output writes do not trigger input reads
+*/
+#include <Arduino.h>
+#include <Wire.h>
+#include "pins.h"
+#include "i2c_bus.h"
+#include "mcp_io.h"
+#include "host_test.h"
+
+/* Register map, IOCON.BANK = 0 */
+#define IODIRA   0x00
+#define IODIRB   0x01
+#define GPINTENA 0x04
+#define GPINTENB 0x05
+#define INTCONA  0x08
+#define IOCON    0x0A
+#define INTFA    0x0E
+#define INTCAPA  0x10
+#define GPIOA    0x12
+#define OLATA    0x14
+#define OLATB    0x15
+#define REG_COUNT 0x16
+
+/* =====================================================
+   MCP23017 MODEL
+   Interrupt on change vs previous value (INTCON = 0),
+   INTA/INTB mirrored onto one active-low line. INTCAP
+   latches the port at the first change; reading INTCAP
+   or GPIO of a port clears its INTF.
+   ===================================================== */
+
+class Mcp23017Model : public HostI2cDevice {
+public:
+  uint8_t reg[REG_COUNT] = {};
+  uint8_t pins[2] = {};
+  uint32_t captureReads = 0;   // read txns that covered INTCAP
+
+  Mcp23017Model() {
+    reg[IODIRA] = 0xFF;
+    reg[IODIRA + 1] = 0xFF;
+  }
+
+  void setInputs(uint8_t port, uint8_t value) {
+    uint8_t en = reg[GPINTENA + port] & reg[IODIRA + port];
+    uint8_t changed = (pins[port] ^ value) & en;
+
+    pins[port] = value;
+
+    if (changed && reg[INTFA + port] == 0) {
+      reg[INTFA + port] = changed;
+      reg[INTCAPA + port] = gpio(port);
+    }
+    updateLine();
+  }
+
+  void i2cWrite(const uint8_t* data, uint8_t n) override {
+    if (n == 0) return;
+    ptr = data[0];
+
+    for (uint8_t i = 1; i < n; i++) {
+      if (ptr == INTFA || ptr == INTFA + 1 || ptr == INTCAPA || ptr == INTCAPA + 1) {
+        // read-only
+      } else if (ptr == GPIOA || ptr == GPIOA + 1) {
+        reg[OLATA + (ptr - GPIOA)] = data[i];
+      } else {
+        reg[ptr] = data[i];
+      }
+      step();
+    }
+  }
+
+  void i2cRead(uint8_t* out, uint8_t n) override {
+    bool cap = false;
+
+    for (uint8_t i = 0; i < n; i++) {
+      if (ptr == GPIOA || ptr == GPIOA + 1) {
+        out[i] = gpio(ptr - GPIOA);
+        reg[INTFA + (ptr - GPIOA)] = 0;
+      } else if (ptr == INTCAPA || ptr == INTCAPA + 1) {
+        out[i] = reg[ptr];
+        reg[INTFA + (ptr - INTCAPA)] = 0;
+        cap = true;
+      } else {
+        out[i] = reg[ptr];
+      }
+      step();
+    }
+
+    if (cap) captureReads++;
+    updateLine();
+  }
+
+private:
+  uint8_t ptr = 0;
+
+  void step() {
+    if (++ptr >= REG_COUNT) ptr = 0;   // SEQOP = 0
+  }
+
+  uint8_t gpio(uint8_t port) const {
+    uint8_t dir = reg[IODIRA + port];
+    return (pins[port] & dir) | (reg[OLATA + port] & ~dir);
+  }
+
+  void updateLine() {
+    bool active = reg[INTFA] | reg[INTFA + 1];
+    if (hostPinLevel[PIN_MCP_INT] != (active ? LOW : HIGH))
+      hostDriveInput(PIN_MCP_INT, active ? LOW : HIGH);
+  }
+};
+
+static Mcp23017Model chip;
+
+static void syncTicks(uint32_t n) {
+  for (uint32_t i = 0; i < n; i++) mcpSync();
+}
+
+static void testInit() {
+  CHECK_EQ(mcpDeviceCount(), 1);
+  CHECK(mcpDevicePresent(0));
+  CHECK_EQ(chip.reg[IOCON] & 0x44, 0x44);
+  CHECK_EQ(chip.reg[IODIRA], 0xFF);
+  CHECK_EQ(chip.reg[IODIRB], 0x00);
+  CHECK_EQ(chip.reg[GPINTENA], 0xFF);
+  CHECK_EQ(chip.reg[GPINTENB], 0x00);
+  CHECK_EQ(chip.reg[INTCONA], 0x00);
+
+  // Startup scan, then nothing pending
+  syncTicks(2);
+  mcpTakeInputChange();
+}
+
+static void testQuietLine() {
+  uint32_t reads = chip.captureReads;
+  uint32_t bursts = mcpGetStats().readBursts;
+  uint32_t irqs = mcpGetStats().interrupts;
+
+  syncTicks(1000);
+
+  CHECK_EQ(chip.captureReads, reads);
+  CHECK_EQ(mcpGetStats().readBursts, bursts);
+  CHECK_EQ(mcpGetStats().interrupts, irqs);
+  CHECK(!mcpTakeInputChange());
+}
+
+static void testEdge() {
+  uint32_t reads = chip.captureReads;
+
+  chip.setInputs(0, 0x05);
+  CHECK_EQ(hostPinLevel[PIN_MCP_INT], LOW);
+
+  mcpSync();
+  CHECK_EQ(chip.captureReads, reads + 1);
+  CHECK_EQ(hostPinLevel[PIN_MCP_INT], HIGH);   // read released the line
+
+  mcpSync();
+  CHECK_EQ(mcpReadDigitalInputs(), 0x05);
+  CHECK(mcpTakeInputChange());
+  CHECK(!mcpTakeInputChange());
+
+  syncTicks(100);
+  CHECK_EQ(chip.captureReads, reads + 1);
+  CHECK(!mcpTakeInputChange());
+}
+
+static void testShortPulse() {
+  uint32_t reads = chip.captureReads;
+
+  // Bit 3 pulses HIGH and is LOW again before the next tick
+  chip.setInputs(0, 0x0D);
+  chip.setInputs(0, 0x05);
+
+  mcpSync();
+  mcpSync();
+  CHECK_EQ(mcpReadDigitalInputs(), 0x0D);
+  CHECK(mcpTakeInputChange());
+
+  // No new interrupt for the fall: the recheck picks it up
+  mcpSync();
+  CHECK_EQ(mcpReadDigitalInputs(), 0x05);
+  CHECK(mcpTakeInputChange());
+  CHECK_EQ(chip.captureReads, reads + 2);
+
+  syncTicks(100);
+  CHECK_EQ(chip.captureReads, reads + 2);
+  CHECK(!mcpTakeInputChange());
+}
+
+static void testOutputsDoNotScan() {
+  uint32_t reads = chip.captureReads;
+
+  mcpSetSwitch(2, true);
+  mcpSync();
+  CHECK_EQ(chip.reg[OLATB], 0x04);
+
+  mcpSetSwitch(2, false);
+  mcpSetSwitch(5, true);
+  mcpSync();
+  CHECK_EQ(chip.reg[OLATB], 0x20);
+
+  CHECK_EQ(chip.captureReads, reads);
+  CHECK(!mcpTakeInputChange());
+}
+
+int main() {
+  hostI2cAttach(MCP23017_ADDR, &chip);
+  hostDriveInput(PIN_MCP_INT, HIGH);   // external pull-up
+
+  i2cBusInit();
+  mcpInit();
+
+  testInit();
+  testQuietLine();
+  testEdge();
+  testShortPulse();
+  testOutputsDoNotScan();
+
+  return hostTestReport("test_mcp_int");
+}
@@ -0,0 +1,131 @@
+/*
+  test_output_stage.cpp
+  ------------------------------------------------------
+  Output stage (output_stage.cpp) on the virtual clock.
+  controlCommitPwm() is replaced by a recorder so every
+  tick's output and its time can be checked.
+
+  Covers:
+    - an unlimited channel reaches a new target at the
+      next tick (at most one control period late)
+    - a slew-limited channel ramps at its limit
+    - snap (failsafe) bypasses the slew limit
+    - latency and loss -> safe stamps are taken in the
+      tick that writes the values, not at publish time
+*/
+#include <Arduino.h>
+#include "output_stage.h"
+#include "latency.h"
+#include "failsafe.h"
+#include "host_test.h"
+
+#define PERIOD_US (1000000UL / OUTPUT_RATE_HZ)
+
+static uint16_t written[CH_COUNT];
+static uint64_t writtenAtUs = 0;
+static uint32_t ticks = 0;
+
+void controlCommitPwm(const uint16_t ch[CH_COUNT]) {
+  memcpy(written, ch, sizeof(written));
+  writtenAtUs = hostMicros();
+  ticks++;
+}
+
+static void publish(const uint16_t ch[CH_COUNT], bool snap = false) {
+  OutputMarks marks;
+  marks.rx = latencyTakeRx(marks.rxUs);
+  marks.trip = failsafeTakeTrip(marks.lastFrameUs);
+  outputStageSetTargets(ch, snap, marks);
+}
+
+static uint16_t neutral[CH_COUNT] = { 2048, 2048, 2048, 2048, 0, 0 };
+
+static void testStepReachedNextTick() {
+  uint16_t ch[CH_COUNT];
+  memcpy(ch, neutral, sizeof(ch));
+  publish(ch);
+  hostAdvanceUs(10 * PERIOD_US);
+
+  // Publish between ticks: LED has no slew limit
+  hostAdvanceUs(PERIOD_US / 3);
+  uint64_t publishedUs = hostMicros();
+  ch[CH_LED] = 4095;
+  publish(ch);
+
+  uint32_t before = ticks;
+  hostAdvanceUs(PERIOD_US);
+  CHECK_EQ(ticks, before + 1);
+  CHECK_EQ(written[CH_LED], 4095);
+  CHECK(writtenAtUs - publishedUs <= PERIOD_US);
+}
+
+static void testSlewRamp() {
+  uint16_t ch[CH_COUNT];
+  memcpy(ch, neutral, sizeof(ch));
+  ch[CH_STEERING] = 4095;
+  publish(ch);
+
+  hostAdvanceUs(PERIOD_US);
+  CHECK_EQ(written[CH_STEERING], 2048 + 82);
+
+  // 2047 units at 82 per tick: 25 ticks in total
+  hostAdvanceUs(23 * PERIOD_US);
+  CHECK(written[CH_STEERING] < 4095);
+  hostAdvanceUs(PERIOD_US);
+  CHECK_EQ(written[CH_STEERING], 4095);
+}
+
+static void testSnapBypassesSlew() {
+  uint16_t ch[CH_COUNT];
+  memcpy(ch, neutral, sizeof(ch));
+  ch[CH_STEERING] = 0;
+  ch[CH_MOTOR_L] = 0;
+  publish(ch, true);
+
+  hostAdvanceUs(PERIOD_US);
+  CHECK_EQ(written[CH_STEERING], 0);
+  CHECK_EQ(written[CH_MOTOR_L], 0);
+}
+
+static void testStampsTakenAtWrite() {
+  uint16_t ch[CH_COUNT];
+  memcpy(ch, neutral, sizeof(ch));
+
+  latencyReset();
+  hostAdvanceUs(PERIOD_US / 4);
+  latencyMarkRx(micros());
+  publish(ch);
+
+  LatencySummary s;
+  latencyGetSummary(s);
+  CHECK_EQ(s.count, 0);   // nothing written yet
+
+  hostAdvanceUs(PERIOD_US);
+  latencyGetSummary(s);
+  CHECK_EQ(s.count, 1);
+  CHECK(s.maxUs > 0 && s.maxUs <= PERIOD_US);
+
+  // Link was up, then lost: loss -> safe is stamped by the tick
+  failsafeFeed();
+  uint64_t lastFrame = hostMicros();
+  hostAdvanceUs((uint64_t)FAILSAFE_TIMEOUT_MS * 1000 + PERIOD_US / 2);
+
+  byte sw = 0;
+  CHECK(failsafeApply(ch, sw));
+  publish(ch, true);
+  CHECK_EQ(failsafeGetStats().lastLossToSafeUs, 0);
+
+  hostAdvanceUs(PERIOD_US);
+  CHECK_EQ(failsafeGetStats().lastLossToSafeUs, writtenAtUs - lastFrame);
+}
+
+int main() {
+  outputStageInit();
+
+  testStepReachedNextTick();
+  testSlewRamp();
+  testSnapBypassesSlew();
+  testStampsTakenAtWrite();
+
+  return hostTestReport("test_output_stage");
+}
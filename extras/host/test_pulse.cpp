@@ -0,0 +1,133 @@
+/*
+  test_pulse.cpp
+  ------------------------------------------------------
+  GPIO pulses (pulse.cpp) against the virtual clock.
+  Built twice: test_pulse (PULSE_USE_TIMER=0, polled
+  min-heap) and test_pulse_timer (esp_timer + the
+  pulse_train.cpp heap, edges fired by hostAdvanceUs()).
+
+  Fires thousands of random pulses, hundreds of them
+  overlapping, on 32 GPIO pins, and checks every pin's
+  level after each 1 ms step against a model: a pin is
+  HIGH until the latest end time requested for it,
+  restarts extend but never shorten a pulse. The clock
+  starts just before the 32-bit millis() wrap.
+
+  Timer mode also checks the edges of pulse trains.
+*/
+#include <Arduino.h>
+#include "pulse.h"
+#include "host_bench.h"
+#include "host_test.h"
+
+#define PINS  32
+#define STEPS 20000
+
+static uint32_t expectedEnd[PINS];
+static bool expectedHigh[PINS];
+
+#if PULSE_USE_TIMER
+
+struct Edge {
+  uint8_t pin;
+  uint8_t level;
+  uint64_t atUs;
+};
+
+static Edge edges[64];
+static uint8_t edgeCount = 0;
+
+static void recordEdge(uint8_t pin, uint8_t level) {
+  if (edgeCount < 64) edges[edgeCount++] = { pin, level, hostMicros() };
+}
+
+static void testTrains() {
+  uint64_t t0 = hostMicros();
+
+  edgeCount = 0;
+  hostOnDigitalWrite = recordEdge;
+
+  // 3 pulses of 300/700 us on pin 5, 2 pulses of 250/250 us on pin 6
+  CHECK(pulseTrainGpio(5, 3, 300, 700));
+  CHECK(pulseTrainGpio(6, 2, 250, 250));
+  hostAdvanceUs(5000);
+
+  hostOnDigitalWrite = nullptr;
+
+  static const Edge expect[] = {
+    { 5, HIGH, 0 }, { 6, HIGH, 0 },
+    { 6, LOW, 250 }, { 5, LOW, 300 }, { 6, HIGH, 500 }, { 6, LOW, 750 },
+    { 5, HIGH, 1000 }, { 5, LOW, 1300 }, { 5, HIGH, 2000 }, { 5, LOW, 2300 },
+  };
+
+  CHECK_EQ(edgeCount, sizeof(expect) / sizeof(expect[0]));
+  for (uint8_t i = 0; i < edgeCount && i < sizeof(expect) / sizeof(expect[0]); i++) {
+    CHECK_EQ(edges[i].pin, expect[i].pin);
+    CHECK_EQ(edges[i].level, expect[i].level);
+    CHECK_EQ(edges[i].atUs - t0, expect[i].atUs);
+  }
+
+  // Stop mid-train drives the pin LOW and cancels its edges
+  CHECK(pulseTrainGpio(5, 100, 100, 100));
+  hostAdvanceUs(150);
+  pulseTrainGpioStop(5);
+  CHECK_EQ(hostPinLevel[5], LOW);
+  hostAdvanceUs(1000);
+  CHECK_EQ(hostPinLevel[5], LOW);
+}
+
+#endif
+
+int main() {
+  BenchRng rng;
+  uint32_t mismatches = 0, maxConcurrent = 0, started = 0;
+
+  hostSetMicros((uint64_t)(0xFFFFFFFFu - 5000) * 1000);
+
+  for (uint32_t step = 0; step < STEPS; step++) {
+    uint32_t n = rng.below(4);
+
+    for (uint32_t k = 0; k < n; k++) {
+      uint8_t pin = (uint8_t)rng.below(PINS);
+      uint16_t ms = (uint16_t)(1 + rng.below(200));
+      uint32_t end = millis() + ms;
+
+      pulseStart(pin, ms);
+      started++;
+
+      if (!expectedHigh[pin] || (int32_t)(end - expectedEnd[pin]) > 0)
+        expectedEnd[pin] = end;
+      expectedHigh[pin] = true;
+    }
+
+    hostAdvanceUs(1000);
+    pulseUpdate();
+
+    uint32_t concurrent = 0;
+    for (uint8_t p = 0; p < PINS; p++) {
+      if (expectedHigh[p] && (int32_t)(millis() - expectedEnd[p]) >= 0)
+        expectedHigh[p] = false;
+
+      if (expectedHigh[p] != (hostPinLevel[p] == HIGH)) mismatches++;
+      if (expectedHigh[p]) concurrent++;
+    }
+    if (concurrent > maxConcurrent) maxConcurrent = concurrent;
+  }
+
+  const PulseStats& st = pulseGetStats();
+
+  CHECK_EQ(mismatches, 0);
+  CHECK_EQ(st.started, started);
+  CHECK_EQ(st.dropped, 0);
+  CHECK(maxConcurrent >= 30);
+
+  printf("  %u pulses, up to %u at once\n", started, maxConcurrent);
+
+#if PULSE_USE_TIMER
+  hostAdvanceUs(300000);   // let the random pulses finish
+  testTrains();
+  return hostTestReport("test_pulse_timer");
+#else
+  return hostTestReport("test_pulse");
+#endif
+}
@@ -0,0 +1,79 @@
+/*
+  test_receiver.cpp
+  ------------------------------------------------------
+  Receiver framing and coalescing on the host.
+
+  Covers:
+    - frames split across calls and surrounded by noise
+    - a backlog much larger than the 64-byte ring decodes
+      the state packet once (latest wins) and still
+      delivers every event, in order
+*/
+#include <Arduino.h>
+#include <vector>
+#include "bluetooth.h"
+#include "receiver.h"
+#include "event_queue.h"
+#include "host_frames.h"
+#include "host_test.h"
+
+static int8_t consumer;
+
+static void feed(const Bytes& b) {
+  SerialBT.hostFeed(b.data(), b.size());
+}
+
+static std::vector<uint8_t> takeEvents() {
+  std::vector<uint8_t> ids;
+  RcEvent e;
+  while (eventQueuePop(consumer, e)) ids.push_back(e.eventId);
+  return ids;
+}
+
+static void testFragmentedAndNoisy() {
+  Bytes s = hostStateFrame(100);
+
+  feed(Bytes{ 0x01, 0xAA, 0x02, 0xBB });
+  feed(Bytes(s.begin(), s.begin() + 7));
+  handleBluetooth();
+  feed(Bytes(s.begin() + 7, s.end()));
+  feed(hostEventFrame(1));
+  handleBluetooth();
+
+  CHECK_EQ(rcStatePacket.data.leftStickX, 100);
+  std::vector<uint8_t> ev = takeEvents();
+  CHECK_EQ(ev.size(), 1);
+  CHECK(receiverGetStats().resyncs > 0);
+}
+
+static void testBacklogDecodesOnce() {
+  ReceiverStats before = receiverGetStats();
+
+  for (uint16_t i = 0; i < 20; i++) {
+    feed(hostStateFrame(1000 + i));
+    if (i % 5 == 4) feed(hostEventFrame((uint8_t)(10 + i)));
+  }
+  handleBluetooth();
+
+  const ReceiverStats& st = receiverGetStats();
+  uint32_t good = st.goodFrames - before.goodFrames;
+  uint32_t coalesced = st.coalesced - before.coalesced;
+
+  CHECK_EQ(good, 24);
+  CHECK_EQ(coalesced, 19);   // 20 state frames, one decode
+  CHECK_EQ(rcStatePacket.data.leftStickX, 1019);
+
+  std::vector<uint8_t> ev = takeEvents();
+  CHECK_EQ(ev.size(), 4);
+  for (size_t i = 0; i < ev.size(); i++) CHECK_EQ(ev[i], 14 + 5 * i);
+}
+
+int main() {
+  receiverInit();
+  consumer = eventQueueSubscribe();
+
+  testFragmentedAndNoisy();
+  testBacklogDecodesOnce();
+
+  return hostTestReport("test_receiver");
+}
@@ -0,0 +1,86 @@
+/*
+  test_rx_task.cpp
+  ------------------------------------------------------
+  RX_USE_TASK=1 on the host: receiverInit() starts the RX
+  task as a real thread, the main thread plays loopTask.
+
+  The main loop "stalls" while far more state frames than
+  RX_QUEUE_DEPTH arrive with a few events mixed in. When
+  it resumes, one handleBluetooth() must deliver the
+  newest state and every event, in order, with nothing
+  dropped from the handoff.
+
+  An event's timestamp is when the RX task framed it, not
+  when the stalled main loop got around to it.
+*/
+#include <Arduino.h>
+#include <thread>
+#include <vector>
+#include "bluetooth.h"
+#include "receiver.h"
+#include "event_queue.h"
+#include "host_frames.h"
+#include "host_test.h"
+
+#if !RX_USE_TASK
+#error "build with -DRX_USE_TASK=1"
+#endif
+
+static void waitForRxTask() {
+  while (SerialBT.available() > 0)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+}
+
+int main() {
+  receiverInit();
+  int8_t consumer = eventQueueSubscribe();
+
+  // Main loop stalled: 200 state frames and 10 events
+  for (uint16_t i = 0; i < 200; i++) {
+    Bytes f = hostStateFrame(500 + i);
+    SerialBT.hostFeed(f.data(), f.size());
+
+    if (i % 20 == 10) {
+      Bytes e = hostEventFrame((uint8_t)(i / 20 + 1));
+      SerialBT.hostFeed(e.data(), e.size());
+    }
+
+    if (i % 8 == 0) std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+  waitForRxTask();
+
+  handleBluetooth();
+
+  const ReceiverStats& st = receiverGetStats();
+  CHECK_EQ(st.goodFrames, 210);
+  CHECK_EQ(st.handoffDrops, 0);
+  CHECK_EQ(st.coalesced, 199);   // only the newest state reached the handler
+  CHECK_EQ(rcStatePacket.data.leftStickX, 699);
+
+  std::vector<uint8_t> ids;
+  RcEvent e;
+  while (eventQueuePop(consumer, e)) ids.push_back(e.eventId);
+
+  CHECK_EQ(ids.size(), 10);
+  for (size_t i = 0; i < ids.size(); i++) CHECK_EQ(ids[i], i + 1);
+
+  // Nothing left over
+  handleBluetooth();
+  CHECK(!eventQueuePop(consumer, e));
+
+  // Event framed at t, dispatched 50 ms later
+  hostAdvanceUs(1000000);
+  uint32_t framedUs = micros();
+  Bytes ev = hostEventFrame(0x42);
+  SerialBT.hostFeed(ev.data(), ev.size());
+  waitForRxTask();
+
+  hostAdvanceUs(50000);
+  handleBluetooth();
+  CHECK(eventQueuePop(consumer, e));
+  CHECK_EQ(e.eventId, 0x42);
+  CHECK_EQ(e.rxUs, framedUs);
+
+  return hostTestReport("test_rx_task");
+}
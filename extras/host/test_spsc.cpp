@@ -0,0 +1,104 @@
+/*
+  test_spsc.cpp
+  ------------------------------------------------------
+  Two-thread stress test for SpscQueue (spsc_queue.h).
+
+  A producer std::thread pushes a numbered sequence while
+  the consumer (main thread) pops it, alternating between
+  the copy API (push/pop) and the in-place API
+  (pushSlot/pushCommit, peekSlot/popCommit). Every item
+  carries a payload derived from its sequence number, so
+  a torn or reordered slot shows up as a mismatch.
+
+  Run it under -fsanitize=thread for a stronger check:
+    make CXXFLAGS="-O1 -g -fsanitize=thread" build/test_spsc
+*/
+#include <thread>
+#include "spsc_queue.h"
+#include "host_test.h"
+
+#define ITEMS 2000000u
+
+// Yield first, then sleep, so the other side gets the CPU
+// even on a single-core host where yield() may not switch
+static void backoff(uint32_t& spins) {
+  if (++spins < 64) std::this_thread::yield();
+  else std::this_thread::sleep_for(std::chrono::microseconds(1));
+}
+
+struct Item {
+  uint32_t seq;
+  uint32_t payload[7];
+};
+
+static uint32_t payloadOf(uint32_t seq, int i) {
+  return seq * 2654435761u + (uint32_t)i;
+}
+
+template <size_t N>
+static void stress() {
+  static SpscQueue<Item, N> q;
+
+  std::thread producer([] {
+    uint32_t spins = 0;
+
+    for (uint32_t seq = 0; seq < ITEMS; seq++) {
+      if (seq & 1) {
+        Item* slot;
+        while ((slot = q.pushSlot()) == nullptr) backoff(spins);
+        slot->seq = seq;
+        for (int i = 0; i < 7; i++) slot->payload[i] = payloadOf(seq, i);
+        q.pushCommit();
+        spins = 0;
+      } else {
+        Item it;
+        it.seq = seq;
+        for (int i = 0; i < 7; i++) it.payload[i] = payloadOf(seq, i);
+        while (!q.push(it)) backoff(spins);
+        spins = 0;
+      }
+    }
+  });
+
+  uint32_t expect = 0, bad = 0, maxSize = 0, spins = 0;
+
+  while (expect < ITEMS) {
+    size_t sz = q.size();
+    if (sz > maxSize) maxSize = (uint32_t)sz;
+
+    Item it;
+    if (expect & 2) {
+      Item* slot = q.peekSlot();
+      if (!slot) {
+        backoff(spins);
+        continue;
+      }
+      it = *slot;
+      q.popCommit();
+    } else if (!q.pop(it)) {
+      backoff(spins);
+      continue;
+    }
+
+    spins = 0;
+    if (it.seq != expect) bad++;
+    for (int i = 0; i < 7; i++)
+      if (it.payload[i] != payloadOf(it.seq, i)) bad++;
+    expect = it.seq + 1;
+  }
+
+  producer.join();
+
+  CHECK_EQ(bad, 0);
+  CHECK(maxSize <= N);
+  CHECK(q.peekSlot() == nullptr);
+  printf("  N=%zu: %u items, max depth seen %u\n", N, ITEMS, maxSize);
+}
+
+int main() {
+  stress<2>();
+  stress<16>();
+  stress<256>();
+
+  return hostTestReport("test_spsc");
+}
@@ -0,0 +1,131 @@
+/*
+  failsafe.cpp
+  ------------------------------------------------------
+  Link-loss detection and safe-value ramping.
+  See failsafe.h.
+*/
+#include "failsafe.h"
+
+/* =====================================================
+   PER-CHANNEL SAFE VALUES
+
+   rampPerMs = 0 -> snap to safeValue immediately
+   rampPerMs > 0 -> move at most this many units per ms
+   ===================================================== */
+
+struct FailsafeChannel {
+  uint16_t safeValue;
+  uint16_t rampPerMs;
+};
+
+static const FailsafeChannel failsafeChannels[CH_COUNT] = {
+  { 2048, 0 },   // steering: center
+  { 0,    8 },   // motor L: stop over ~0.5 s
+  { 0,    8 },   // motor R: stop over ~0.5 s
+  { 2048, 0 },   // camera pan: center
+  { 0,    0 },   // LED off
+  { 0,    0 },   // buzzer off
+};
+
+static const byte failsafeSwitches = 0x00;   // all switches off
+
+/* =====================================================
+   STATE
+   ===================================================== */
+
+static uint32_t lastFrameUs = 0;
+static bool everFed = false;
+
+static uint16_t current[CH_COUNT];   // values output while in failsafe
+static uint32_t lastStepMs = 0;
+static uint32_t tripMs = 0;
+static bool rampDone = false;
+static bool tripPending = false;     // loss -> safe not stamped yet
+
+static FailsafeStats stats = {0, 0, 0, false};
+
+static uint16_t stepToward(uint16_t v, uint16_t target, uint32_t maxStep) {
+  if (v < target) return ((uint32_t)(target - v) > maxStep) ? v + maxStep : target;
+  if (v > target) return ((uint32_t)(v - target) > maxStep) ? v - maxStep : target;
+  return v;
+}
+
+/* =====================================================
+   PUBLIC
+   ===================================================== */
+
+void failsafeFeed() {
+  lastFrameUs = micros();
+  everFed = true;
+  stats.active = false;
+}
+
+bool failsafeApply(uint16_t ch[CH_COUNT], byte& switches) {
+
+  // Latched until failsafeFeed(): the 32-bit micros() gap wraps
+  // after ~71.6 min of silence and would read as a fresh link
+  uint32_t nowUs = micros();
+  bool lost = stats.active || !everFed ||
+              (nowUs - lastFrameUs) >= (uint32_t)FAILSAFE_TIMEOUT_MS * 1000UL;
+
+  if (!lost) return false;
+
+  uint32_t nowMs = millis();
+
+  if (!stats.active) {
+    // Entering failsafe: ramp from what was last commanded
+    stats.active = true;
+    stats.trips++;
+    stats.lastLossToSafeUs = 0;   // stamped by failsafeMarkSafe()
+    stats.lastRampMs = 0;
+    tripPending = everFed;
+
+    for (uint8_t i = 0; i < CH_COUNT; i++) current[i] = ch[i];
+
+    lastStepMs = nowMs;
+    tripMs = nowMs;
+    rampDone = false;
+  }
+
+  uint32_t dt = nowMs - lastStepMs;
+  lastStepMs = nowMs;
+
+  bool allSafe = true;
+
+  for (uint8_t i = 0; i < CH_COUNT; i++) {
+    const FailsafeChannel& fc = failsafeChannels[i];
+
+    if (fc.rampPerMs == 0) {
+      current[i] = fc.safeValue;
+    } else {
+      current[i] = stepToward(current[i], fc.safeValue, dt * fc.rampPerMs);
+    }
+
+    if (current[i] != fc.safeValue) allSafe = false;
+    ch[i] = current[i];
+  }
+
+  switches = failsafeSwitches;
+
+  if (allSafe && !rampDone) {
+    rampDone = true;
+    stats.lastRampMs = nowMs - tripMs;
+  }
+
+  return true;
+}
+
+bool failsafeTakeTrip(uint32_t& frameUs) {
+  if (!tripPending) return false;
+  tripPending = false;
+  frameUs = lastFrameUs;
+  return true;
+}
+
+void failsafeMarkSafe(uint32_t frameUs) {
+  stats.lastLossToSafeUs = micros() - frameUs;
+}
+
+const FailsafeStats& failsafeGetStats() {
+  return stats;
+}
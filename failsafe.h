@@ -0,0 +1,50 @@
+/*
+  failsafe.h
+  ------------------------------------------------------
+  Link-loss failsafe for the control layer.
+
+  If no valid state packet arrives for
+  FAILSAFE_MISSED_PACKETS x FAILSAFE_PACKET_PERIOD_MS,
+  controlUpdate() stops using rcStatePacket and drives each
+  channel to its safe value (snap, or ramp at a per-channel
+  rate). It stays engaged however long the link is down;
+  only the next valid state packet (failsafeFeed()) hands
+  control straight back to the app.
+
+  Channel values are in RcPacket units (0–4095), before
+  mapping, so the same table works for servos, motors,
+  LED and buzzer.
+*/
+#ifndef FAILSAFE_H
+#define FAILSAFE_H
+
+#include <Arduino.h>
+#include "control.h"
+
+#define FAILSAFE_PACKET_PERIOD_MS  20   // app sends state at ~50 Hz
+#define FAILSAFE_MISSED_PACKETS    3
+#define FAILSAFE_TIMEOUT_MS (FAILSAFE_PACKET_PERIOD_MS * FAILSAFE_MISSED_PACKETS)
+
+struct FailsafeStats {
+  uint32_t trips;            // times failsafe engaged
+  uint32_t lastLossToSafeUs; // last valid frame -> first safe output
+  uint32_t lastRampMs;       // first safe output -> all channels at safe value
+  bool active;
+};
+
+// A valid state packet was received
+void failsafeFeed();
+
+// Replaces ch[]/switches with failsafe values when the link is lost.
+// Returns true while failsafe is active.
+bool failsafeApply(uint16_t ch[CH_COUNT], byte& switches);
+
+// Once per trip (after a link that was up): time of the last
+// valid frame. Pass it to failsafeMarkSafe() once the first
+// safe values have actually been written.
+bool failsafeTakeTrip(uint32_t& lastFrameUs);
+void failsafeMarkSafe(uint32_t lastFrameUs);   // safe from any task
+
+const FailsafeStats& failsafeGetStats();
+
+#endif
@@ -0,0 +1,85 @@
+/*
+  fast_map.h
+  ------------------------------------------------------
+  Compile-time replacements for Arduino map() on 12-bit
+  inputs (0–4095), used in the control hot path.
+
+  Two implementations, same results as map() for every
+  input 0–4095 (integer truncation included):
+
+  • FAST_MAP_RECIPROCAL (default, no flash cost)
+      out = outMin + ((x * M) >> 32), with M a rounded-up
+      fixed-point reciprocal computed at compile time.
+      One 32x32->64 multiply instead of multiply + divide.
+
+  • FAST_MAP_LUT
+      4096-entry table per output range, generated by a
+      constexpr constructor and stored in flash
+      (8 KB per 16-bit range, 4 KB per 8-bit range).
+      Costs flash; can lose to the reciprocal on a cache
+      miss, so measure before switching.
+
+  Select with FAST_MAP_MODE below.
+*/
+#ifndef FAST_MAP_H
+#define FAST_MAP_H
+
+#include <stdint.h>
+#include <type_traits>
+
+#define FAST_MAP_RECIPROCAL 0
+#define FAST_MAP_LUT        1
+
+#ifndef FAST_MAP_MODE
+#define FAST_MAP_MODE FAST_MAP_RECIPROCAL
+#endif
+
+#define FAST_MAP_IN_MAX 4095
+
+template <uint16_t OUT_MIN, uint16_t OUT_MAX>
+struct FastMap {
+  static_assert(OUT_MAX >= OUT_MIN, "FastMap: decreasing ranges not supported");
+
+  static constexpr uint32_t RISE = OUT_MAX - OUT_MIN;
+
+  // ceil(RISE * 2^32 / IN_MAX): exact floor division for x <= 4095
+  static constexpr uint64_t M =
+    (((uint64_t)RISE << 32) + FAST_MAP_IN_MAX - 1) / FAST_MAP_IN_MAX;
+
+  static constexpr uint16_t compute(uint16_t x) {
+    return (uint16_t)(OUT_MIN + (uint32_t)(((uint64_t)x * M) >> 32));
+  }
+
+#if FAST_MAP_MODE == FAST_MAP_LUT
+  // Smallest entry type that holds OUT_MAX
+  typedef typename std::conditional<(OUT_MAX <= 0xFF), uint8_t, uint16_t>::type Entry;
+
+  struct Table {
+    Entry v[FAST_MAP_IN_MAX + 1];
+
+    constexpr Table() : v() {
+      for (uint32_t x = 0; x <= FAST_MAP_IN_MAX; x++)
+        v[x] = (Entry)(OUT_MIN + x * RISE / FAST_MAP_IN_MAX);
+    }
+  };
+
+  static constexpr Table table{};
+#endif
+
+  static inline uint16_t apply(uint16_t x) {
+    if (x > FAST_MAP_IN_MAX) x = FAST_MAP_IN_MAX;
+
+#if FAST_MAP_MODE == FAST_MAP_LUT
+    return table.v[x];
+#else
+    return compute(x);
+#endif
+  }
+};
+
+#if FAST_MAP_MODE == FAST_MAP_LUT
+template <uint16_t OUT_MIN, uint16_t OUT_MAX>
+constexpr typename FastMap<OUT_MIN, OUT_MAX>::Table FastMap<OUT_MIN, OUT_MAX>::table;
+#endif
+
+#endif
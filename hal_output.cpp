@@ -3,6 +3,7 @@
 #include "mcp_io.h"
 #include "pulse.h"
 #include "feature_config.h"
+#include "hal_outputs.h"
 
 /* ================= PWM ================= */
 
@@ -44,30 +45,25 @@ void halSetSwitch(uint8_t index, bool state) {
     digitalWrite(pins[index], state);
 
 #elif PROJECT_MODE == FULL_RC_MODE_MCP
-  const uint8_t mcpPins[6] = {
-    GPB0, GPB1, GPB2,
-    GPB3, GPB4, GPB5
-  };
-
-  if (index < 6)
-    mcpWriteOutput(mcpPins[index], state);
+  // Unified index, mapped to (device, port, bit) in mcp_io.cpp
+  mcpSetSwitch(index, state);
 #endif
 }
 
 /* ================= PULSES ================= */
 
-void halPulseSwitch(uint8_t index) {
+void halPulseSwitch(uint8_t index, uint16_t durationMs) {
 
 #if PROJECT_MODE == FULL_RC_MODE_MCP
   const uint8_t mcpPulsePins[2] = { GPB6, GPB7 };
 
   if (index < 2)
-    mcpPulseStart(mcpPulsePins[index]);
+    mcpPulseStart(mcpPulsePins[index], durationMs);
 
 #else
   const uint8_t gpioPulsePins[2] = { PIN_FREE1, PIN_FREE2 };
 
   if (index < 2)
-    pulseStart(gpioPulsePins[index]);
+    pulseStart(gpioPulsePins[index], durationMs);
 #endif
 }
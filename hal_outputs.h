@@ -13,4 +13,4 @@ void halSetBuzzer(uint32_t value);
 void halSetSwitch(uint8_t index, bool state);
 
 /* Pulse Outputs */
-void halPulseSwitch(uint8_t index);
\ No newline at end of file
+void halPulseSwitch(uint8_t index, uint16_t durationMs = 50);
\ No newline at end of file
@@ -1,7 +1,177 @@
 #include <Wire.h>
 #include "pins.h"
 #include "i2c_bus.h"
+#include "spsc_queue.h"
+
+/* =====================================================
+   QUEUES (one per priority, main loop -> bus task)
+   ===================================================== */
+
+static SpscQueue<I2cTxn*, I2C_QUEUE_DEPTH> queues[I2C_PRIO_COUNT];
+static I2cStats stats = { 0, 0, 0, 0, 0 };
+
+#if I2C_USE_TASK
+static TaskHandle_t busTask = nullptr;
+
+// Given when a txn i2cTransfer() waits on completes.
+// Only the main loop submits, so there is one waiter.
+static SemaphoreHandle_t doneSem = nullptr;
+#endif
+
+/* =====================================================
+   EXECUTION (bus task, or caller when I2C_USE_TASK = 0)
+   ===================================================== */
+
+static void i2cRun(I2cTxn& t) {
+  uint32_t start = micros();
+  bool ok = true;
+
+  if (t.txLen > 0) {
+    Wire.beginTransmission(t.addr);
+    Wire.write(t.tx, t.txLen);
+    // Keep the bus for the read that follows
+    ok = Wire.endTransmission(t.rxLen == 0) == 0;
+  }
+
+  if (ok && t.rxLen > 0) {
+    uint8_t got = Wire.requestFrom(t.addr, t.rxLen);
+    ok = (got == t.rxLen);
+    for (uint8_t i = 0; i < got; i++) t.rx[i] = Wire.read();
+  }
+
+  uint32_t us = micros() - start;
+  t.busUs = us > 0xFFFF ? 0xFFFF : (uint16_t)us;
+  stats.busyUs += us;
+
+  if (ok) stats.completed++;
+  else stats.failed++;
+
+  // Read before the status store: once the txn is no longer
+  // pending the caller may reuse or release it
+  bool wake = t.wake;
+
+  t.status.store(ok ? I2C_DONE : I2C_FAILED, std::memory_order_release);
+
+#if I2C_USE_TASK
+  if (wake) xSemaphoreGive(doneSem);
+#else
+  (void)wake;
+#endif
+}
+
+#if I2C_USE_TASK
+// Highest-priority txn waiting, or nullptr
+static I2cTxn* i2cNext(uint8_t& prio) {
+  for (prio = 0; prio < I2C_PRIO_COUNT; prio++) {
+    I2cTxn** slot = queues[prio].peekSlot();
+    if (slot) return *slot;
+  }
+  return nullptr;
+}
+
+static void i2cTask(void*) {
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    // Re-pick after every txn so a new output write
+    // never waits behind more than one sensor read
+    uint8_t prio;
+    I2cTxn* t;
+
+    while ((t = i2cNext(prio)) != nullptr) {
+      i2cRun(*t);
+      queues[prio].popCommit();
+    }
+  }
+}
+#endif
+
+/* =====================================================
+   PUBLIC
+   ===================================================== */
 
 void i2cBusInit() {
-    Wire.begin(PIN_I2C_SDA, PIN_I2C_SCL);
-}
\ No newline at end of file
+  Wire.begin(PIN_I2C_SDA, PIN_I2C_SCL);
+
+#if I2C_USE_TASK
+  doneSem = xSemaphoreCreateBinary();
+  xTaskCreatePinnedToCore(i2cTask, "i2c", I2C_TASK_STACK, nullptr,
+                          I2C_TASK_PRIORITY, &busTask, I2C_TASK_CORE);
+#endif
+}
+
+void i2cTxnWrite(I2cTxn& t, uint8_t addr, uint8_t reg, const uint8_t* data, uint8_t n) {
+  if (n > I2C_TX_MAX - 1) n = I2C_TX_MAX - 1;
+
+  t.addr = addr;
+  t.tx[0] = reg;
+  memcpy(&t.tx[1], data, n);
+  t.txLen = n + 1;
+  t.rxLen = 0;
+  t.rx = nullptr;
+}
+
+void i2cTxnRead(I2cTxn& t, uint8_t addr, uint8_t reg, uint8_t* rx, uint8_t n) {
+  t.addr = addr;
+  t.tx[0] = reg;
+  t.txLen = 1;
+  t.rxLen = n;
+  t.rx = rx;
+}
+
+static bool i2cQueue(I2cTxn& t, I2cPriority prio, bool wake) {
+
+  if (i2cPending(t)) {
+    stats.rejected++;
+    return false;
+  }
+
+  t.wake = wake;
+  t.status.store(I2C_PENDING, std::memory_order_relaxed);
+
+#if I2C_USE_TASK
+  if (!queues[prio].push(&t)) {
+    t.status.store(I2C_IDLE, std::memory_order_relaxed);
+    stats.rejected++;
+    return false;
+  }
+
+  stats.submitted++;
+  xTaskNotifyGive(busTask);
+#else
+  stats.submitted++;
+  i2cRun(t);
+#endif
+
+  return true;
+}
+
+bool i2cSubmit(I2cTxn& t, I2cPriority prio) {
+  return i2cQueue(t, prio, false);
+}
+
+bool i2cTransfer(I2cTxn& t, I2cPriority prio) {
+  if (!i2cQueue(t, prio, true)) return false;
+
+#if I2C_USE_TASK
+  // Wakes as soon as the bus task finishes this txn. A give
+  // left over from a txn that finished before its waiter
+  // blocked only costs one extra pass through the loop.
+  while (i2cPending(t)) xSemaphoreTake(doneSem, portMAX_DELAY);
+#endif
+
+  return i2cTakeResult(t) == I2C_DONE;
+}
+
+I2cStatus i2cTakeResult(I2cTxn& t) {
+  uint8_t s = t.status.load(std::memory_order_acquire);
+
+  if (s == I2C_DONE || s == I2C_FAILED)
+    t.status.store(I2C_IDLE, std::memory_order_relaxed);
+
+  return (I2cStatus)s;
+}
+
+const I2cStats& i2cGetStats() {
+  return stats;
+}
@@ -1,6 +1,96 @@
+/*
+  i2c_bus.h
+  ------------------------------------------------------
+  Shared I2C bus with a queued transaction layer.
+
+  Purpose:
+  --------
+  Drivers (MCP23017, sensors) never call Wire directly.
+  They fill an I2cTxn they own, submit it with a priority
+  and check its status on a later tick. A bus task runs
+  the transactions, always taking the most urgent queue
+  first, so output writes go ahead of sensor polls and a
+  slow sensor never stalls controlUpdate().
+
+  Rules:
+  ------
+  • Submit only from the main loop (queues are SPSC).
+  • A txn and its rx buffer must stay valid until it is
+    no longer pending; do not touch it meanwhile.
+*/
 #ifndef I2C_BUS_H
 #define I2C_BUS_H
 
+#include <Arduino.h>
+#include <atomic>
+
+#ifndef I2C_USE_TASK
+#define I2C_USE_TASK      1     // 0 = i2cSubmit() runs the txn inline
+#endif
+#define I2C_TASK_STACK    3072
+#define I2C_TASK_PRIORITY 2     // above loopTask (1)
+#define I2C_TASK_CORE     1
+#define I2C_QUEUE_DEPTH   8     // per priority, power of two
+#define I2C_TX_MAX        8     // register + payload bytes
+
+enum I2cPriority : uint8_t {
+  I2C_PRIO_OUTPUT = 0,   // expander output latches
+  I2C_PRIO_INPUT,        // expander input scans
+  I2C_PRIO_SENSOR,       // sensor polls
+  I2C_PRIO_COUNT
+};
+
+enum I2cStatus : uint8_t {
+  I2C_IDLE = 0,
+  I2C_PENDING,
+  I2C_DONE,
+  I2C_FAILED
+};
+
+struct I2cTxn {
+  uint8_t addr;
+  uint8_t txLen;
+  uint8_t tx[I2C_TX_MAX];
+  uint8_t rxLen;
+  uint8_t* rx;                      // caller-owned, rxLen bytes
+  uint16_t busUs;                   // time it held the bus
+  bool wake;                        // i2cTransfer() is blocked on it
+  std::atomic<uint8_t> status;      // I2cStatus
+};
+
+struct I2cStats {
+  uint32_t submitted;
+  uint32_t completed;
+  uint32_t failed;
+  uint32_t rejected;   // queue full or txn still pending
+  uint32_t busyUs;     // total time spent on the bus
+};
+
 void i2cBusInit();
 
-#endif
\ No newline at end of file
+/* ---------- TXN BUILDERS ---------- */
+
+// reg followed by n payload bytes (n <= I2C_TX_MAX - 1)
+void i2cTxnWrite(I2cTxn& t, uint8_t addr, uint8_t reg, const uint8_t* data, uint8_t n);
+
+// reg, repeated start, then n bytes into rx
+void i2cTxnRead(I2cTxn& t, uint8_t addr, uint8_t reg, uint8_t* rx, uint8_t n);
+
+/* ---------- SUBMIT / COMPLETE ---------- */
+
+bool i2cSubmit(I2cTxn& t, I2cPriority prio);
+
+// Submit and block until the bus task completes it
+// (init, and write-through mode); sleeps, never polls
+bool i2cTransfer(I2cTxn& t, I2cPriority prio);
+
+inline bool i2cPending(const I2cTxn& t) {
+  return t.status.load(std::memory_order_acquire) == I2C_PENDING;
+}
+
+// DONE / FAILED once, then back to IDLE
+I2cStatus i2cTakeResult(I2cTxn& t);
+
+const I2cStats& i2cGetStats();
+
+#endif
@@ -1,54 +1,124 @@
 #include <Arduino.h>
-#include <Wire.h>
 #include "packets.h"
 #include "bluetooth.h"
+#include "link.h"
 #include "pins.h"
-
-#define I2C_ADDR_TEMP 0x48
-#define I2C_ADDR_IMU  0x68
+#include "sensor_driver.h"
+#include "temp_sensor.h"
+#include "imu.h"
+#include "attitude.h"
+#include "i2c_sensors.h"
 
 static unsigned long lastSend = 0;
 const unsigned long i2cInterval = 100;
 
-uint16_t readTemp() {
-  Wire.beginTransmission(I2C_ADDR_TEMP);
-  Wire.write(0);
-  Wire.endTransmission();
-  Wire.requestFrom(I2C_ADDR_TEMP,2);
-  return (Wire.read()<<8)|Wire.read();
+/* =====================================================
+   DRIVER REGISTRY
+   Add a sensor by listing its driver here.
+   ===================================================== */
+
+static const SensorDriver* const drivers[] = {
+  &tempSensorDriver,
+  &imuSensorDriver,
+};
+
+#define SENSOR_COUNT (sizeof(drivers) / sizeof(drivers[0]))
+
+/* =====================================================
+   SCHEDULE
+   Each present sensor runs on its own period; a missed
+   deadline is not made up in a burst, the next one is
+   set from now.
+   ===================================================== */
+
+static bool present[SENSOR_COUNT];
+static unsigned long deadline[SENSOR_COUNT];
+
+void i2cSensorsInit() {
+  unsigned long now = millis();
+
+  for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+    present[i] = drivers[i]->probe();
+    if (present[i]) drivers[i]->configure();
+    deadline[i] = now;
+  }
+
+  // Runs on every IMU sample once the MPU-6050 is found
+  attitudeInit();
 }
 
-void readIMU(int16_t &ax,int16_t &ay,int16_t &az) {
-  Wire.beginTransmission(I2C_ADDR_IMU);
-  Wire.write(0x3B);
-  Wire.endTransmission(false);
-  Wire.requestFrom(I2C_ADDR_IMU,6);
-  ax = (Wire.read()<<8)|Wire.read();
-  ay = (Wire.read()<<8)|Wire.read();
-  az = (Wire.read()<<8)|Wire.read();
+void i2cSensorsUpdate() {
+  unsigned long now = millis();
+
+  for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+    if (!present[i]) continue;
+
+    const SensorDriver* d = drivers[i];
+
+    if (d->periodMs != 0) {
+      if ((long)(now - deadline[i]) < 0) continue;
+
+      deadline[i] += d->periodMs;
+      if ((long)(now - deadline[i]) >= 0) deadline[i] = now + d->periodMs;
+    }
+
+    d->sample();
+  }
 }
 
+/* =====================================================
+   TELEMETRY (0xCC 0x66, variable length)
+   Sent every interval, like the fixed packet was; only
+   present sensors with a valid reading are listed, so
+   count is 0 when nothing is fitted.
+   ===================================================== */
+
 void sendI2CTelemetry() {
   if(!SerialBT.hasClient()) return;
   if(millis()-lastSend<i2cInterval) return;
   lastSend=millis();
 
-  int16_t ax,ay,az;
+  byte buf[5 + SENSOR_COUNT * (2 + 2 * SENSOR_MAX_VALUES) + 1];
+  int idx = 0;
+
+  buf[idx++] = 0xCC;
+  buf[idx++] = 0x66;
+
+  int lengthIndex = idx;
+  buf[idx++] = 0;  // len low
+  buf[idx++] = 0;  // len high
+
+  int countIndex = idx;
+  buf[idx++] = 0;  // sensor count
+
+  for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+    if (!present[i]) continue;
 
-  i2cPacket.h1=0xCC;
-  i2cPacket.h2=0x66;
-  i2cPacket.temp = readTemp();
-  readIMU(ax,ay,az);
+    const SensorDriver* d = drivers[i];
+    int16_t values[SENSOR_MAX_VALUES];
 
-  i2cPacket.ax=ax;
-  i2cPacket.ay=ay;
-  i2cPacket.az=az;
-  i2cPacket.sensorFlags = 0b00000011;
+    if (!d->read(values)) continue;
 
-  byte c=0;
-  for(int i=2;i<I2C_PACKET_SIZE-1;i++)
-    c+=((byte*)&i2cPacket)[i];
+    buf[idx++] = d->id;
+    buf[idx++] = d->valueCount;
 
-  i2cPacket.checksum=c;
-  SerialBT.write((byte*)&i2cPacket,I2C_PACKET_SIZE);
-}
\ No newline at end of file
+    for (uint8_t v = 0; v < d->valueCount; v++) {
+      buf[idx++] = (uint16_t)values[v] & 0xFF;
+      buf[idx++] = ((uint16_t)values[v] >> 8) & 0xFF;
+    }
+
+    buf[countIndex]++;
+  }
+
+  uint16_t payloadLength = idx - 4;
+  buf[lengthIndex] = payloadLength & 0xFF;
+  buf[lengthIndex + 1] = (payloadLength >> 8) & 0xFF;
+
+  uint8_t checksum = 0;
+  for (int i = 2; i < idx; i++)
+    checksum += buf[i];
+
+  buf[idx++] = checksum;
+
+  linkWrite(buf, idx);
+}
@@ -14,24 +14,38 @@
    It does NOT parse incoming data.
    It only sends telemetry.
 
+   Sensors are drivers (sensor_driver.h) listed in a
+   registry. Presence is probed once at boot; each present
+   sensor is then sampled on its own period, and absent
+   ones are never touched again.
+
    Packet ID:
-     0xCC 0x66
+     0xCC 0x66, lenL, lenH, count,
+     count x { id, n, n x int16 (little endian) },
+     checksum
+   Sent every 100 ms while a client is connected. Only
+   present sensors with a valid reading are listed; with
+   none fitted the packet still goes out with count 0.
 
    Functions:
    ----------
-   void i2cInit();
+   void i2cSensorsInit();
+   void i2cSensorsUpdate();
    void sendI2CTelemetry();
 
    ESPAÑOL:
    --------
    Este módulo lee sensores I2C (temperatura, IMU, etc.)
    y los envía como telemetría a la app Android.
+   Cada sensor presente se muestrea con su propio
+   periodo; el paquete solo incluye sensores presentes.
 
    No procesa datos entrantes.
    Solo envía telemetría.
    ===================================================== */
 
-void i2cInit();
+void i2cSensorsInit();
+void i2cSensorsUpdate();   // every loop: runs due sensor samples
 void sendI2CTelemetry();
 
 #endif
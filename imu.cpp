@@ -0,0 +1,246 @@
+/*
+  imu.cpp
+  ------------------------------------------------------
+  MPU-6050 FIFO driver. See imu.h.
+*/
+#include "imu.h"
+#include "i2c_bus.h"
+
+/* MPU-6050 Registers */
+#define SMPLRT_DIV   0x19
+#define CONFIG       0x1A
+#define GYRO_CONFIG  0x1B
+#define ACCEL_CONFIG 0x1C
+#define FIFO_EN      0x23
+#define USER_CTRL    0x6A
+#define PWR_MGMT_1   0x6B
+#define FIFO_COUNTH  0x72
+#define FIFO_R_W     0x74
+
+#define FIFO_EN_ACCEL      0x08
+#define FIFO_EN_GYRO_XYZ   0x70
+#define USER_CTRL_FIFO_EN  0x40
+#define USER_CTRL_FIFO_RST 0x04
+#define PWR_CLK_PLL_GYROX  0x01
+#define DLPF_44HZ          0x03    // gyro output rate becomes 1 kHz
+
+#define FIFO_SIZE      1024
+#define SAMPLE_BYTES   12          // ax, ay, az, gx, gy, gz (big endian)
+
+/* =====================================================
+   STATE
+   ===================================================== */
+
+enum ImuState : uint8_t {
+  IMU_IDLE,          // waiting for the next poll
+  IMU_WAIT_COUNT,    // FIFO_COUNT read queued
+  IMU_WAIT_DATA,     // FIFO burst queued
+  IMU_WAIT_RESET     // FIFO reset queued
+};
+
+static bool present = false;
+static ImuState state = IMU_IDLE;
+static unsigned long lastPoll = 0;
+static uint16_t backlog = 0;       // bytes still in the FIFO after this burst
+
+static I2cTxn txn;
+static uint8_t countBuf[2];
+static uint8_t fifoBuf[IMU_BURST_SAMPLES * SAMPLE_BYTES];
+
+static ImuConsumerFn consumers[IMU_MAX_CONSUMERS];
+static uint8_t consumerCount = 0;
+
+static int32_t lpf[3];             // Q8
+static bool lpfPrimed = false;
+
+static ImuStats stats = { 0, 0, 0, 0 };
+
+/* =====================================================
+   HELPERS
+   ===================================================== */
+
+static bool imuWrite(uint8_t reg, uint8_t value) {
+  i2cTxnWrite(txn, I2C_ADDR_IMU, reg, &value, 1);
+  return i2cTransfer(txn, I2C_PRIO_SENSOR);
+}
+
+static void imuQueueFifoReset() {
+  uint8_t v = USER_CTRL_FIFO_EN | USER_CTRL_FIFO_RST;
+  i2cTxnWrite(txn, I2C_ADDR_IMU, USER_CTRL, &v, 1);
+  if (i2cSubmit(txn, I2C_PRIO_SENSOR)) state = IMU_WAIT_RESET;
+}
+
+static void imuQueueCount() {
+  i2cTxnRead(txn, I2C_ADDR_IMU, FIFO_COUNTH, countBuf, 2);
+  if (i2cSubmit(txn, I2C_PRIO_SENSOR)) state = IMU_WAIT_COUNT;
+}
+
+static void imuQueueBurst(uint16_t bytes) {
+  uint16_t samples = bytes / SAMPLE_BYTES;
+  if (samples > IMU_BURST_SAMPLES) samples = IMU_BURST_SAMPLES;
+
+  uint16_t len = samples * SAMPLE_BYTES;
+  backlog = bytes - len;
+
+  i2cTxnRead(txn, I2C_ADDR_IMU, FIFO_R_W, fifoBuf, (uint8_t)len);
+  if (i2cSubmit(txn, I2C_PRIO_SENSOR)) state = IMU_WAIT_DATA;
+}
+
+static void imuFilter(const ImuSample& s) {
+  int32_t x[3] = { s.ax, s.ay, s.az };
+
+  for (uint8_t i = 0; i < 3; i++) {
+    if (!lpfPrimed) lpf[i] = x[i] * 256;
+    else lpf[i] += (x[i] * 256 - lpf[i]) >> IMU_LPF_SHIFT;
+  }
+
+  lpfPrimed = true;
+}
+
+static void imuDispatch(uint8_t samples) {
+  for (uint8_t n = 0; n < samples; n++) {
+    const uint8_t* b = &fifoBuf[n * SAMPLE_BYTES];
+
+    ImuSample s;
+    s.ax = (int16_t)((b[0] << 8) | b[1]);
+    s.ay = (int16_t)((b[2] << 8) | b[3]);
+    s.az = (int16_t)((b[4] << 8) | b[5]);
+    s.gx = (int16_t)((b[6] << 8) | b[7]);
+    s.gy = (int16_t)((b[8] << 8) | b[9]);
+    s.gz = (int16_t)((b[10] << 8) | b[11]);
+
+    imuFilter(s);
+
+    for (uint8_t i = 0; i < consumerCount; i++)
+      consumers[i](s);
+  }
+
+  stats.samples += samples;
+  stats.bursts++;
+}
+
+/* =====================================================
+   PUBLIC
+   ===================================================== */
+
+static bool imuProbe() {
+  // Wake up, clock from the X gyro PLL (more stable than the RC osc)
+  present = imuWrite(PWR_MGMT_1, PWR_CLK_PLL_GYROX);
+  return present;
+}
+
+static void imuConfigure() {
+  imuWrite(CONFIG, DLPF_44HZ);
+  imuWrite(SMPLRT_DIV, (uint8_t)(1000 / IMU_RATE_HZ - 1));
+  imuWrite(GYRO_CONFIG, 0x08);                          // ±500 °/s
+  imuWrite(ACCEL_CONFIG, 0x00);                         // ±2 g
+  imuWrite(FIFO_EN, FIFO_EN_ACCEL | FIFO_EN_GYRO_XYZ);
+  imuWrite(USER_CTRL, USER_CTRL_FIFO_EN | USER_CTRL_FIFO_RST);
+
+  state = IMU_IDLE;
+  lastPoll = millis();
+}
+
+bool imuInit() {
+  if (!imuProbe()) return false;
+  imuConfigure();
+  return true;
+}
+
+bool imuPresent() {
+  return present;
+}
+
+void imuUpdate() {
+  if (!present) return;
+
+  switch (state) {
+
+    case IMU_IDLE:
+      // Keep draining without waiting while samples are left over
+      if (backlog >= SAMPLE_BYTES) {
+        imuQueueCount();
+      } else if (millis() - lastPoll >= IMU_POLL_MS) {
+        lastPoll = millis();
+        imuQueueCount();
+      }
+      break;
+
+    case IMU_WAIT_COUNT: {
+      if (i2cPending(txn)) break;
+
+      if (i2cTakeResult(txn) != I2C_DONE) {
+        stats.errors++;
+        state = IMU_IDLE;
+        break;
+      }
+
+      uint16_t count = ((uint16_t)countBuf[0] << 8) | countBuf[1];
+
+      if (count >= FIFO_SIZE) {
+        // Overflowed: oldest samples are gone, realign to a frame
+        stats.overflows++;
+        backlog = 0;
+        imuQueueFifoReset();
+      } else if (count >= SAMPLE_BYTES) {
+        imuQueueBurst(count);
+      } else {
+        backlog = 0;
+        state = IMU_IDLE;
+      }
+      break;
+    }
+
+    case IMU_WAIT_DATA:
+      if (i2cPending(txn)) break;
+
+      if (i2cTakeResult(txn) == I2C_DONE)
+        imuDispatch(txn.rxLen / SAMPLE_BYTES);
+      else
+        stats.errors++;
+
+      state = IMU_IDLE;
+      break;
+
+    case IMU_WAIT_RESET:
+      if (i2cPending(txn)) break;
+
+      if (i2cTakeResult(txn) != I2C_DONE) stats.errors++;
+      state = IMU_IDLE;
+      break;
+  }
+}
+
+bool imuAddConsumer(ImuConsumerFn fn) {
+  if (consumerCount >= IMU_MAX_CONSUMERS) return false;
+  consumers[consumerCount++] = fn;
+  return true;
+}
+
+bool imuGetFiltered(int16_t& ax, int16_t& ay, int16_t& az) {
+  if (!lpfPrimed) return false;
+
+  ax = (int16_t)((lpf[0] + 128) >> 8);
+  ay = (int16_t)((lpf[1] + 128) >> 8);
+  az = (int16_t)((lpf[2] + 128) >> 8);
+  return true;
+}
+
+const ImuStats& imuGetStats() {
+  return stats;
+}
+
+/* =====================================================
+   SENSOR DRIVER
+   ===================================================== */
+
+static bool imuRead(int16_t* values) {
+  return imuGetFiltered(values[0], values[1], values[2]);
+}
+
+// Period 0: imuUpdate() keeps its own poll timer and must
+// run every loop to move its bus transactions along
+const SensorDriver imuSensorDriver = {
+  "mpu6050", SENSOR_ID_ACCEL, 3, 0,
+  imuProbe, imuConfigure, imuUpdate, imuRead
+};
@@ -0,0 +1,70 @@
+/*
+  imu.h
+  ------------------------------------------------------
+  MPU-6050 acquisition through the sensor FIFO.
+
+  The chip samples the accelerometer and gyro at
+  IMU_RATE_HZ into its own FIFO. imuUpdate() polls the FIFO level every
+  IMU_POLL_MS and pulls everything queued in one burst
+  read on the shared I2C bus, so no sample is lost
+  between polls and the main loop never waits.
+
+  Every sample is:
+  • handed at full rate to the registered consumers
+    (on-device users such as an attitude filter), and
+  • fed to a fixed-point low-pass filter whose output
+    imuGetFiltered() returns for telemetry (the packet
+    rate decimates it).
+*/
+#ifndef IMU_H
+#define IMU_H
+
+#include <Arduino.h>
+#include "sensor_driver.h"
+
+#define I2C_ADDR_IMU       0x68
+
+#define IMU_RATE_HZ        200   // FIFO sample rate (1 kHz / (1 + SMPLRT_DIV))
+#define IMU_POLL_MS        20
+#define IMU_BURST_SAMPLES  10    // per read, fits the 128-byte Wire buffer
+#define IMU_GYRO_LSB_PER_DPS_X10 655   // ±500 °/s full scale
+#define IMU_LPF_SHIFT      3     // y += (x - y) / 8, ~4 Hz at 200 Hz
+#define IMU_MAX_CONSUMERS  4
+
+struct ImuSample {
+  int16_t ax;
+  int16_t ay;
+  int16_t az;
+  int16_t gx;
+  int16_t gy;
+  int16_t gz;
+};
+
+typedef void (*ImuConsumerFn)(const ImuSample& s);
+
+struct ImuStats {
+  uint32_t samples;     // samples read from the FIFO
+  uint32_t bursts;      // FIFO burst reads
+  uint32_t overflows;   // FIFO filled up and was reset
+  uint32_t errors;      // failed bus transactions
+};
+
+// Returns false if no MPU-6050 answered
+bool imuInit();
+bool imuPresent();
+
+// Call every loop: advances the poll / burst state machine
+void imuUpdate();
+
+// Full-rate sample callback (runs in the main loop)
+bool imuAddConsumer(ImuConsumerFn fn);
+
+// Low-passed acceleration; false until the first sample
+bool imuGetFiltered(int16_t& ax, int16_t& ay, int16_t& az);
+
+const ImuStats& imuGetStats();
+
+// Registry entry: sample = imuUpdate(), read = low-passed ax, ay, az
+extern const SensorDriver imuSensorDriver;
+
+#endif
@@ -1,5 +1,6 @@
 #include <Arduino.h>
 #include "bluetooth.h"
+#include "link.h"
 #include "packets.h"
 #include "input.h"
 #include "pins.h"
@@ -33,7 +34,7 @@ void inputUpdate() {
     inputPacket.checksum =
         calculateChecksum((uint8_t*)&inputPacket, INPUT_PACKET_SIZE);
 
-    SerialBT.write((uint8_t*)&inputPacket, INPUT_PACKET_SIZE);
+    linkWrite((uint8_t*)&inputPacket, INPUT_PACKET_SIZE);
 }
 
 /*
@@ -1,6 +1,7 @@
 #include <Arduino.h>
 #include "input_hw.h"
 #include "pins.h"
+#include "mcp_io.h"
 
 /* =====================================================
    INTERNAL DIGITAL MASK BUILDER (Telemetry side)
@@ -106,5 +107,9 @@ uint8_t hwReadPlot3() {
 }
 
 uint8_t hwReadDigitalMask() {
+#if USE_MCP23017
+    return mcpReadDigitalInputs();      // captured by mcpSync()
+#else
     return buildDigitalMaskInternal();
+#endif
 }
@@ -0,0 +1,104 @@
+/*
+  latency.cpp
+  ------------------------------------------------------
+  Fixed-bucket RX -> output latency histogram.
+  See latency.h.
+*/
+#include "latency.h"
+
+#define LAT_SUB_BITS 2                      // 4 buckets per octave
+#define LAT_SUB      (1 << LAT_SUB_BITS)
+#define LAT_MAX_MSB  21                     // up to ~4 s
+#define LAT_BUCKETS  ((LAT_MAX_MSB - LAT_SUB_BITS + 2) * LAT_SUB)
+
+static uint32_t buckets[LAT_BUCKETS];
+static uint32_t sampleCount = 0;
+static uint32_t maxUs = 0;
+
+// Histogram is written from the output stage timer task
+static portMUX_TYPE histMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Pending frame: main loop only
+static uint32_t pendingRxUs = 0;
+static bool pendingRx = false;
+
+static uint16_t bucketOf(uint32_t us) {
+  if (us < LAT_SUB) return us;
+
+  uint8_t msb = 31 - __builtin_clz(us);
+  if (msb > LAT_MAX_MSB) return LAT_BUCKETS - 1;
+
+  uint8_t sub = (us >> (msb - LAT_SUB_BITS)) & (LAT_SUB - 1);
+  return (msb - LAT_SUB_BITS + 1) * LAT_SUB + sub;
+}
+
+static uint32_t bucketUpperUs(uint16_t b) {
+  if (b < LAT_SUB) return b;
+
+  uint8_t msb = b / LAT_SUB + LAT_SUB_BITS - 1;
+  uint8_t sub = b % LAT_SUB;
+  return ((uint32_t)(LAT_SUB + sub + 1) << (msb - LAT_SUB_BITS)) - 1;
+}
+
+static uint32_t percentileUs(uint32_t permille) {
+  if (sampleCount == 0) return 0;
+
+  uint32_t rank = (uint32_t)(((uint64_t)sampleCount * permille + 999) / 1000);
+  uint32_t seen = 0;
+
+  for (uint16_t b = 0; b < LAT_BUCKETS; b++) {
+    seen += buckets[b];
+    if (seen >= rank) {
+      uint32_t up = bucketUpperUs(b);
+      return up < maxUs ? up : maxUs;
+    }
+  }
+
+  return maxUs;
+}
+
+void latencyMarkRx(uint32_t rxUs) {
+  // Only the newest frame counts: the one the next commit uses
+  pendingRxUs = rxUs;
+  pendingRx = true;
+}
+
+bool latencyTakeRx(uint32_t& rxUs) {
+  if (!pendingRx) return false;
+  pendingRx = false;
+  rxUs = pendingRxUs;
+  return true;
+}
+
+void latencyRecord(uint32_t rxUs) {
+  uint32_t us = micros() - rxUs;
+  uint16_t b = bucketOf(us);
+
+  portENTER_CRITICAL(&histMux);
+  buckets[b]++;
+  sampleCount++;
+  if (us > maxUs) maxUs = us;
+  portEXIT_CRITICAL(&histMux);
+}
+
+void latencyMarkCommit() {
+  uint32_t rxUs;
+  if (latencyTakeRx(rxUs)) latencyRecord(rxUs);
+}
+
+void latencyGetSummary(LatencySummary& out) {
+  portENTER_CRITICAL(&histMux);
+  out.count = sampleCount;
+  out.p50Us = percentileUs(500);
+  out.p99Us = percentileUs(990);
+  out.maxUs = maxUs;
+  portEXIT_CRITICAL(&histMux);
+}
+
+void latencyReset() {
+  portENTER_CRITICAL(&histMux);
+  memset(buckets, 0, sizeof(buckets));
+  sampleCount = 0;
+  maxUs = 0;
+  portEXIT_CRITICAL(&histMux);
+}
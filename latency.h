@@ -0,0 +1,45 @@
+/*
+  latency.h
+  ------------------------------------------------------
+  End-to-end command latency: time from a state packet
+  being fully received (receiver.cpp) to the outputs
+  being written from it (controlUpdate(), or the output
+  stage tick when OUTPUT_STAGE_ENABLED).
+
+  Samples go into a fixed log-scale histogram (4 buckets
+  per power of two, no allocation). Percentiles are the
+  upper edge of the bucket they fall in, so they are
+  accurate to about 25%.
+
+  Readable over Serial (DBG_LATENCY) and sent to the app
+  as a LatencyPacket (CC 88).
+*/
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include <Arduino.h>
+
+struct LatencySummary {
+  uint32_t count;
+  uint32_t p50Us;
+  uint32_t p99Us;
+  uint32_t maxUs;
+};
+
+// Frame completion time (micros()) of the state packet
+// that was just copied into rcStatePacket
+void latencyMarkRx(uint32_t rxUs);
+
+// Outputs were committed from rcStatePacket
+void latencyMarkCommit();
+
+// Split form of latencyMarkCommit() for outputs written by
+// another task: take the pending frame time where the
+// values are computed, record it where they are written.
+bool latencyTakeRx(uint32_t& rxUs);
+void latencyRecord(uint32_t rxUs);   // safe from any task
+
+void latencyGetSummary(LatencySummary& out);
+void latencyReset();
+
+#endif
@@ -0,0 +1,49 @@
+/*
+  link.cpp
+  ------------------------------------------------------
+  Framing mode state and framed TX. See link.h.
+*/
+#include "link.h"
+#include "bluetooth.h"
+#include "packets.h"
+#include "cobs.h"
+
+static volatile LinkFraming framing = LINK_FRAMING_LEGACY;
+
+LinkFraming linkGetFraming() {
+  return framing;
+}
+
+void linkHandleFramingRequest(byte mode) {
+  if (mode > LINK_FRAMING_COBS) mode = LINK_FRAMING_LEGACY;
+
+  // Ack in the framing the app is currently listening for
+  FramingPacket ack;
+  ack.startByte1 = 0xCC;
+  ack.startByte2 = 0x77;
+  ack.mode = mode;
+  ack.checksum = calculateChecksum((uint8_t*)&ack, FRAMING_PACKET_SIZE);
+  linkWrite((uint8_t*)&ack, FRAMING_PACKET_SIZE);
+
+  framing = (LinkFraming)mode;
+}
+
+void linkUpdate() {
+  if (!SerialBT.hasClient())
+    framing = LINK_FRAMING_LEGACY;
+}
+
+void linkWrite(const uint8_t* pkt, size_t len) {
+  if (framing == LINK_FRAMING_LEGACY) {
+    SerialBT.write(pkt, len);
+    return;
+  }
+
+  static uint8_t txBuf[COBS_MAX_ENCODED(LINK_TX_MAX) + 1];
+
+  if (len > LINK_TX_MAX) return;
+
+  size_t n = cobsEncode(pkt, len, txBuf);
+  txBuf[n++] = 0x00;
+  SerialBT.write(txBuf, n);
+}
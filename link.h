@@ -0,0 +1,48 @@
+/*
+  link.h
+  ------------------------------------------------------
+  Bluetooth link framing (shared by RX and TX).
+
+  Modes:
+  ------
+  • LINK_FRAMING_LEGACY (default)
+      Packets are sent raw; the receiver hunts for the
+      two header bytes (AA 55, BB 66, CC xx ...).
+
+  • LINK_FRAMING_COBS
+      Each packet (headers and checksum unchanged) is
+      COBS-encoded and followed by a 0x00 delimiter, so
+      resync is one delimiter search per frame and a
+      payload byte can never fake a header.
+
+  Negotiation:
+  ------------
+  The app sends a legacy FramingPacket (DD 77 mode cs).
+  The ESP32 answers with CC 77 mode cs in the CURRENT
+  framing, then switches both directions. The link drops
+  back to legacy whenever the client disconnects.
+*/
+#ifndef LINK_H
+#define LINK_H
+
+#include <Arduino.h>
+
+enum LinkFraming : uint8_t {
+  LINK_FRAMING_LEGACY = 0,
+  LINK_FRAMING_COBS   = 1
+};
+
+#define LINK_TX_MAX 256   // largest packet linkWrite() accepts
+
+LinkFraming linkGetFraming();
+
+// Handles a FramingPacket request from the app (ack + switch)
+void linkHandleFramingRequest(byte mode);
+
+// Reverts to legacy framing when the client is gone
+void linkUpdate();
+
+// Sends one complete packet using the current framing
+void linkWrite(const uint8_t* pkt, size_t len);
+
+#endif
@@ -1,80 +1,440 @@
-#include <Wire.h>
 #include "mcp_io.h"
+#include "pins.h"
+#include "i2c_bus.h"
 
-/* MCP23017 Registers */
+/* MCP23017 Registers (IOCON.BANK = 0) */
 #define IODIRA   0x00
 #define IODIRB   0x01
+#define GPINTENA 0x04
+#define INTCONA  0x08
+#define IOCON    0x0A
+#define INTFA    0x0E
+#define INTCAPA  0x10
 #define GPIOA    0x12
 #define GPIOB    0x13
+#define OLATA    0x14
 #define OLATB    0x15
 
-static uint8_t portBState = 0x00;
+/* IOCON bits */
+#define IOCON_MIRROR 0x40   // INTA and INTB act as one line
+#define IOCON_ODR    0x04   // open-drain INT, can be wired-OR
 
 /* =====================================================
-   Low Level Write
+   DEVICE TABLE
+   One row per fitted expander, at MCP23017_ADDR + index.
+   Direction bits: 1 = input.
    ===================================================== */
-static void mcpWriteRegister(uint8_t reg, uint8_t value) {
-    Wire.beginTransmission(MCP23017_ADDR);
-    Wire.write(reg);
-    Wire.write(value);
-    Wire.endTransmission();
+
+struct McpDeviceConfig {
+    uint8_t dirA;
+    uint8_t dirB;
+};
+
+static const McpDeviceConfig deviceConfig[] = {
+    { 0xFF, 0x00 },   // 0x20: Port A indicators, Port B switches / events
+};
+
+#define MCP_DEVICES (sizeof(deviceConfig) / sizeof(deviceConfig[0]))
+
+static_assert(MCP_DEVICES <= MCP_MAX_DEVICES, "MCP23017 addresses 0x20-0x27 only");
+
+/* =====================================================
+   UNIFIED INDEX MAPS
+   ===================================================== */
+
+/* { device, port, bit }: switches on GPB0–GPB5 (GPB6/7 are event pulses) */
+static const McpPin switchMap[] = {
+    { 0, 1, 0 }, { 0, 1, 1 }, { 0, 1, 2 },
+    { 0, 1, 3 }, { 0, 1, 4 }, { 0, 1, 5 },
+};
+
+/* Indicators on GPA0–GPA7 */
+static const McpPin indicatorMap[] = {
+    { 0, 0, 0 }, { 0, 0, 1 }, { 0, 0, 2 }, { 0, 0, 3 },
+    { 0, 0, 4 }, { 0, 0, 5 }, { 0, 0, 6 }, { 0, 0, 7 },
+};
+
+#define SWITCH_COUNT    (sizeof(switchMap) / sizeof(switchMap[0]))
+#define INDICATOR_COUNT (sizeof(indicatorMap) / sizeof(indicatorMap[0]))
+
+/* =====================================================
+   Per-Device State
+   Index 0 = port A, 1 = port B. Registers of a pair sit
+   at consecutive addresses, so with sequential mode
+   (IOCON.SEQOP = 0) one transaction covers both ports.
+   ===================================================== */
+
+struct McpDevice {
+    bool present;
+    uint8_t iodir[2];
+    uint8_t olat[2];
+    uint8_t gpio[2];
+    bool iodirDirty;
+    bool olatDirty;
+
+    I2cTxn olatTxn;
+    I2cTxn iodirTxn;
+    I2cTxn inputTxn;
+
+#if MCP_INT_ENABLED
+    uint8_t inputRegs[6];     // INTFA, INTFB, INTCAPA, INTCAPB, GPIOA, GPIOB
+    bool recheck;             // port moved again after INTCAP latched
+    bool inputWasRecheck;
+#else
+    uint8_t inputRegs[2];     // GPIOA, GPIOB
+#endif
+};
+
+static McpDevice devices[MCP_DEVICES];
+
+static McpStats stats = { 0, 0, 0, 0, 0, 0, 0 };
+
+static bool inputChanged = false;
+
+#if MCP_INT_ENABLED
+static volatile bool intPending = false;
+
+static void IRAM_ATTR mcpIntIsr() {
+    intPending = true;
+}
+#endif
+
+static inline uint8_t mcpAddr(uint8_t device) {
+    return MCP23017_ADDR + device;
+}
+
+static inline bool hasInputs(const McpDevice& d) {
+    return (d.iodir[0] | d.iodir[1]) != 0;
 }
 
 /* =====================================================
-   Low Level Read
+   Blocking Access (init, and write-through mode)
+   Still goes through the bus queue, then waits.
    ===================================================== */
-static uint8_t mcpReadRegister(uint8_t reg) {
-    Wire.beginTransmission(MCP23017_ADDR);
-    Wire.write(reg);
-    Wire.endTransmission();
-    Wire.requestFrom(MCP23017_ADDR, (uint8_t)1);
-    return Wire.read();
+static I2cTxn syncTxn;
+
+static bool mcpWriteRegister(uint8_t device, uint8_t reg, uint8_t value) {
+    i2cTxnWrite(syncTxn, mcpAddr(device), reg, &value, 1);
+    return i2cTransfer(syncTxn, I2C_PRIO_OUTPUT);
 }
 
+/* Sequential burst (register pair A, B) */
+static void mcpWritePair(uint8_t device, uint8_t reg, const uint8_t value[2]) {
+    i2cTxnWrite(syncTxn, mcpAddr(device), reg, value, 2);
+    i2cTransfer(syncTxn, I2C_PRIO_OUTPUT);
+    stats.writeBursts++;
+}
+
+static void mcpReadPair(uint8_t device, uint8_t reg, uint8_t value[2]) {
+    i2cTxnRead(syncTxn, mcpAddr(device), reg, value, 2);
+    i2cTransfer(syncTxn, I2C_PRIO_INPUT);
+    stats.readBursts++;
+}
 
 /* =====================================================
    Initialization
    ===================================================== */
 void mcpInit() {
 
-    /* Port A → INPUT (Indicators) */
-    mcpWriteRegister(IODIRA, 0xFF);
+    for (uint8_t i = 0; i < MCP_DEVICES; i++) {
+        McpDevice& d = devices[i];
+
+        /* BANK = 0, SEQOP = 0: pairs are adjacent, address auto-increments.
+           An unanswered write means nothing is fitted at this address. */
+#if MCP_INT_ENABLED
+        d.present = mcpWriteRegister(i, IOCON, IOCON_MIRROR | IOCON_ODR);
+#else
+        d.present = mcpWriteRegister(i, IOCON, 0x00);
+#endif
+        if (!d.present) continue;
+
+        d.iodir[0] = deviceConfig[i].dirA;
+        d.iodir[1] = deviceConfig[i].dirB;
+        mcpWritePair(i, IODIRA, d.iodir);
+
+        /* Clear outputs */
+        d.olat[0] = 0x00;
+        d.olat[1] = 0x00;
+        mcpWritePair(i, OLATA, d.olat);
+
+        d.iodirDirty = false;
+        d.olatDirty = false;
+
+        mcpReadPair(i, GPIOA, d.gpio);
+
+#if MCP_INT_ENABLED
+        /* Input pins: interrupt on any change vs previous value */
+        static const uint8_t zero[2] = { 0x00, 0x00 };
+        mcpWritePair(i, INTCONA, zero);
+        mcpWritePair(i, GPINTENA, d.iodir);
+
+        d.recheck = false;
+#endif
+    }
+
+#if MCP_INT_ENABLED
+    pinMode(PIN_MCP_INT, INPUT);
+    attachInterrupt(digitalPinToInterrupt(PIN_MCP_INT), mcpIntIsr, FALLING);
+
+    /* Clears anything latched before the ISR was attached */
+    intPending = true;
+#endif
+
+    inputChanged = true;
+}
+
+uint8_t mcpDeviceCount() {
+    return MCP_DEVICES;
+}
+
+bool mcpDevicePresent(uint8_t device) {
+    return device < MCP_DEVICES && devices[device].present;
+}
+
+/* =====================================================
+   Raw Pin Access
+   ===================================================== */
+static void mcpWriteLatch(uint8_t device, uint8_t port, uint8_t value) {
+
+    McpDevice& d = devices[device];
+
+    if (value == d.olat[port]) return;
+
+    d.olat[port] = value;
+
+#if MCP_SHADOW_ENABLED
+    if (d.olatDirty) stats.writesMerged++;
+    d.olatDirty = true;
+#else
+    if (d.present) mcpWritePair(device, OLATA, d.olat);
+#endif
+}
+
+void mcpWritePin(McpPin pin, bool state) {
+
+    if (pin.device >= MCP_DEVICES || pin.port > 1 || pin.bit > 7) return;
+
+    uint8_t value = devices[pin.device].olat[pin.port];
+
+    if (state)
+        value |= (1 << pin.bit);
+    else
+        value &= ~(1 << pin.bit);
+
+    mcpWriteLatch(pin.device, pin.port, value);
+}
+
+bool mcpReadPin(McpPin pin) {
+
+    if (pin.device >= MCP_DEVICES || pin.port > 1 || pin.bit > 7) return false;
 
-    /* Port B → OUTPUT (Switches / Events) */
-    mcpWriteRegister(IODIRB, 0x00);
+    return devices[pin.device].gpio[pin.port] & (1 << pin.bit);   // refreshed by mcpSync()
+}
+
+/* =====================================================
+   Unified Index
+   ===================================================== */
+uint8_t mcpSwitchCount() {
+    return SWITCH_COUNT;
+}
+
+uint8_t mcpIndicatorCount() {
+    return INDICATOR_COUNT;
+}
+
+void mcpSetSwitch(uint8_t index, bool state) {
+    if (index < SWITCH_COUNT) mcpWritePin(switchMap[index], state);
+}
 
-    /* Clear outputs */
-    portBState = 0x00;
-    mcpWriteRegister(GPIOB, portBState);
+bool mcpGetIndicator(uint8_t index) {
+    return index < INDICATOR_COUNT && mcpReadPin(indicatorMap[index]);
 }
 
 /* =====================================================
-   Read 8 Digital Inputs (Port A)
+   Read 8 Digital Inputs (Indicators 0–7)
    ===================================================== */
 uint8_t mcpReadDigitalInputs() {
-    return mcpReadRegister(GPIOA);
+    uint8_t mask = 0;
+
+    for (uint8_t i = 0; i < INDICATOR_COUNT && i < 8; i++)
+        if (mcpReadPin(indicatorMap[i])) mask |= (1 << i);
+
+    return mask;
 }
 
 /* =====================================================
-   Write Single Output (Port B)
+   Write Single Output (Device 0, Port B)
    pin: 0–7  (mapped to MCP pins 8–15)
    ===================================================== */
 void mcpWriteOutput(uint8_t pin, bool state) {
+    McpPin p = { 0, 1, pin };
+    mcpWritePin(p, state);
+}
 
-    if (pin > 7) return;
+/* =====================================================
+   Write Entire Port B at Once (Device 0)
+   ===================================================== */
+void mcpWritePortB(uint8_t value) {
+    mcpWriteLatch(0, 1, value);
+}
 
-    if (state)
-        portBState |= (1 << pin);
-    else
-        portBState &= ~(1 << pin);
+/* =====================================================
+   Port Direction
+   ===================================================== */
+void mcpSetDirection(uint8_t device, uint8_t dirA, uint8_t dirB) {
+
+    if (device >= MCP_DEVICES) return;
+
+    McpDevice& d = devices[device];
+
+    if (dirA == d.iodir[0] && dirB == d.iodir[1]) return;
+
+    d.iodir[0] = dirA;
+    d.iodir[1] = dirB;
 
-    mcpWriteRegister(GPIOB, portBState);
+#if MCP_SHADOW_ENABLED
+    d.iodirDirty = true;
+#else
+    if (d.present) mcpWritePair(device, IODIRA, d.iodir);
+#endif
 }
 
 /* =====================================================
-   Write Entire Port B at Once
+   Per-Tick Sync (non-blocking)
+   Writes are queued, latches first so a pin turned
+   output starts at its new level instead of glitching
+   through the old one. A txn still in flight keeps its
+   register dirty, and the change rides the next burst.
+   Input results land one tick after the read is queued.
    ===================================================== */
-void mcpWritePortB(uint8_t value) {
-    portBState = value;
-    mcpWriteRegister(GPIOB, portBState);
-}
\ No newline at end of file
+
+static uint32_t tickBusUs = 0;
+
+// Collects a finished txn's bus time; true if it succeeded
+static bool mcpCollect(I2cTxn& t) {
+    I2cStatus s = i2cTakeResult(t);
+
+    if (s == I2C_DONE || s == I2C_FAILED) tickBusUs += t.busUs;
+
+    return s == I2C_DONE;
+}
+
+static void mcpTakeInputs(McpDevice& d) {
+    if (!mcpCollect(d.inputTxn)) return;
+
+#if MCP_INT_ENABLED
+    d.recheck = false;
+
+    for (uint8_t p = 0; p < 2; p++) {
+        uint8_t intf = d.inputRegs[0 + p];
+        uint8_t cap  = d.inputRegs[2 + p];
+        uint8_t now  = d.inputRegs[4 + p];
+
+        if (!d.inputWasRecheck && intf != 0) {
+            /* Publish the state latched at the edge, so a short
+               pulse is seen even if it is already over. If the
+               port has moved on since, report that next tick
+               (no new interrupt fires for it). */
+            d.gpio[p] = cap;
+            if (now != cap) d.recheck = true;
+        } else {
+            d.gpio[p] = now;
+        }
+    }
+#else
+    d.gpio[0] = d.inputRegs[0];
+    d.gpio[1] = d.inputRegs[1];
+#endif
+}
+
+static void mcpQueueInput(McpDevice& d, uint8_t device, bool fired) {
+
+    if (!hasInputs(d) || i2cPending(d.inputTxn)) return;
+
+#if MCP_INT_ENABLED
+    if (!fired && !d.recheck) return;
+
+    d.inputWasRecheck = !fired;
+
+    /* Reading INTCAP/GPIO releases the INT line */
+    i2cTxnRead(d.inputTxn, mcpAddr(device), INTFA, d.inputRegs, 6);
+#else
+    i2cTxnRead(d.inputTxn, mcpAddr(device), GPIOA, d.inputRegs, 2);
+#endif
+
+    if (i2cSubmit(d.inputTxn, I2C_PRIO_INPUT)) stats.readBursts++;
+}
+
+void mcpSync() {
+
+    tickBusUs = 0;
+    bool changed = false;
+
+#if MCP_INT_ENABLED
+    /* Line still LOW also counts: covers an edge that came
+       in while the previous capture was being cleared. */
+    bool fired = intPending || digitalRead(PIN_MCP_INT) == LOW;
+
+    if (fired) {
+        intPending = false;
+        stats.interrupts++;
+    }
+#else
+    bool fired = true;
+#endif
+
+    if (fired) stats.scans++;
+
+    for (uint8_t i = 0; i < MCP_DEVICES; i++) {
+        McpDevice& d = devices[i];
+
+        if (!d.present) continue;
+
+#if MCP_SHADOW_ENABLED
+        mcpCollect(d.olatTxn);
+        mcpCollect(d.iodirTxn);
+
+        if (d.olatDirty && !i2cPending(d.olatTxn)) {
+            i2cTxnWrite(d.olatTxn, mcpAddr(i), OLATA, d.olat, 2);
+            if (i2cSubmit(d.olatTxn, I2C_PRIO_OUTPUT)) {
+                d.olatDirty = false;
+                stats.writeBursts++;
+            }
+        }
+
+        if (d.iodirDirty && !i2cPending(d.iodirTxn)) {
+            i2cTxnWrite(d.iodirTxn, mcpAddr(i), IODIRA, d.iodir, 2);
+            if (i2cSubmit(d.iodirTxn, I2C_PRIO_OUTPUT)) {
+                d.iodirDirty = false;
+                stats.writeBursts++;
+            }
+        }
+#endif
+
+        uint8_t prevA = d.gpio[0];
+        uint8_t prevB = d.gpio[1];
+
+        mcpTakeInputs(d);
+        mcpQueueInput(d, i, fired);
+
+        // Only input pins count; output pins read back their latch
+        if (((d.gpio[0] ^ prevA) & d.iodir[0]) ||
+            ((d.gpio[1] ^ prevB) & d.iodir[1]))
+            changed = true;
+    }
+
+    if (changed) inputChanged = true;
+
+    stats.tickBusUs = tickBusUs > 0xFFFF ? 0xFFFF : (uint16_t)tickBusUs;
+    if (stats.tickBusUs > stats.maxTickBusUs) stats.maxTickBusUs = stats.tickBusUs;
+}
+
+bool mcpTakeInputChange() {
+    bool changed = inputChanged;
+    inputChanged = false;
+    return changed;
+}
+
+const McpStats& mcpGetStats() {
+    return stats;
+}
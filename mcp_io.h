@@ -3,25 +3,103 @@
 
 #include <Arduino.h>
 
-/* MCP23017 I2C Address */
-#define MCP23017_ADDR 0x20
+/* MCP23017 I2C Address (A2..A0 = 0); device n sits at +n */
+#define MCP23017_ADDR   0x20
+#define MCP_MAX_DEVICES 8
+
+/* =============================
+   Shadow Register Mode
+   1 = writes only update RAM copies of IODIR/OLAT;
+       mcpSync() queues what changed, one sequential
+       OLATA+OLATB burst per device.
+   0 = output writes go to the bus immediately (blocking).
+   Inputs are always scanned by mcpSync().
+   ============================= */
+#define MCP_SHADOW_ENABLED 1
+
+/* =============================
+   Input Interrupt-on-Change
+   1 = input pin changes pull the shared INT line LOW
+       (every device: IOCON.MIRROR + open-drain, wired
+       together to PIN_MCP_INT in pins.h);
+       mcpSync() only scans when the line fired.
+   0 = mcpSync() scans every tick.
+   ============================= */
+#define MCP_INT_ENABLED 1
+
+/* =============================
+   Pin Addressing
+   ============================= */
+struct McpPin {
+  uint8_t device;   // 0 = MCP23017_ADDR, 1 = +1, ...
+  uint8_t port;     // 0 = A, 1 = B
+  uint8_t bit;      // 0–7
+};
 
 /* =============================
    Initialization
+   Probes every device in the table; absent ones
+   are skipped from then on.
    ============================= */
 void mcpInit();
 
+uint8_t mcpDeviceCount();
+bool mcpDevicePresent(uint8_t device);
+
+/* =============================
+   Unified Switch / Indicator Index
+   Switch n and indicator n map onto (device, port, bit)
+   through the tables in mcp_io.cpp.
+   ============================= */
+uint8_t mcpSwitchCount();
+uint8_t mcpIndicatorCount();
+
+void mcpSetSwitch(uint8_t index, bool state);
+bool mcpGetIndicator(uint8_t index);
+
 /* =============================
    Digital Inputs (Indicators)
-   Reads Port A (GPIO 0–7)
+   Indicators 0–7 as a bit mask
    ============================= */
 uint8_t mcpReadDigitalInputs();
 
 /* =============================
    Digital Outputs (Switches / Events)
-   Writes to Port B (GPIO 8–15)
+   Device 0, Port B (GPIO 8–15)
    ============================= */
 void mcpWriteOutput(uint8_t pin, bool state);
 void mcpWritePortB(uint8_t value);
 
-#endif
\ No newline at end of file
+/* =============================
+   Raw Pin Access
+   ============================= */
+void mcpWritePin(McpPin pin, bool state);
+bool mcpReadPin(McpPin pin);
+
+/* =============================
+   Port Direction (1 = input)
+   ============================= */
+void mcpSetDirection(uint8_t device, uint8_t dirA, uint8_t dirB);
+
+/* =============================
+   Once per control tick:
+   flush dirty registers, scan inputs
+   ============================= */
+void mcpSync();
+
+// True once after an input change was captured
+bool mcpTakeInputChange();
+
+struct McpStats {
+  uint32_t writeBursts;     // OLAT / IODIR bursts sent
+  uint32_t readBursts;      // input bursts read
+  uint32_t writesMerged;    // output changes folded into a burst
+  uint32_t interrupts;      // INT line activity seen
+  uint32_t scans;           // input passes over all devices
+  uint16_t tickBusUs;       // bus time of txns finished last tick
+  uint16_t maxTickBusUs;
+};
+
+const McpStats& mcpGetStats();
+
+#endif
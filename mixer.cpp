@@ -0,0 +1,59 @@
+/*
+  mixer.cpp
+  ------------------------------------------------------
+  Q2.14 mixer matrix. See mixer.h.
+*/
+#include "mixer.h"
+
+#define MIX_IN_MAX 4095
+
+// Neutral value of each channel (stick centered, knob at 0)
+static const int16_t mixCenter[CH_COUNT] = {
+  2048,   // steering
+  2048,   // motor L
+  2048,   // motor R
+  2048,   // camera pan
+  0,      // LED knob
+  0,      // buzzer knob
+};
+
+static int16_t mixWeights[CH_COUNT][CH_COUNT];   // [out][in]
+
+void mixerInit() {
+  for (uint8_t o = 0; o < CH_COUNT; o++)
+    for (uint8_t i = 0; i < CH_COUNT; i++)
+      mixWeights[o][i] = (o == i) ? MIX_ONE : 0;
+}
+
+void mixerSetWeight(uint8_t out, uint8_t in, int16_t weightQ14) {
+  if (out >= CH_COUNT || in >= CH_COUNT) return;
+  mixWeights[out][in] = weightQ14;
+}
+
+int16_t mixerGetWeight(uint8_t out, uint8_t in) {
+  if (out >= CH_COUNT || in >= CH_COUNT) return 0;
+  return mixWeights[out][in];
+}
+
+void mixerApply(uint16_t ch[CH_COUNT]) {
+  int32_t in[CH_COUNT];
+
+  for (uint8_t i = 0; i < CH_COUNT; i++)
+    in[i] = (int32_t)ch[i] - mixCenter[i];
+
+  for (uint8_t o = 0; o < CH_COUNT; o++) {
+    const int16_t* w = mixWeights[o];
+    int32_t acc = 0;
+
+    // |in| <= 4095, |w| <= 32767: 6 terms fit easily in 32 bits
+    for (uint8_t i = 0; i < CH_COUNT; i++)
+      acc += w[i] * in[i];
+
+    // Round to nearest (arithmetic shift floors negatives)
+    int32_t v = mixCenter[o] + ((acc + (1 << (MIX_SHIFT - 1))) >> MIX_SHIFT);
+
+    if (v < 0) v = 0;
+    if (v > MIX_IN_MAX) v = MIX_IN_MAX;
+    ch[o] = (uint16_t)v;
+  }
+}
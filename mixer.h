@@ -0,0 +1,43 @@
+/*
+  mixer.h
+  ------------------------------------------------------
+  Fixed-point channel mixer.
+
+  Every control tick the mixer computes each output
+  channel as a weighted sum of all input channels:
+
+      out[o] = outCenter[o] + sum_i( w[o][i] * (in[i] - inCenter[i]) ) >> 14
+
+  Weights are Q2.14 integers (MIX_ONE = 1.0, range about
+  -2.0 .. +2.0). Results are clamped to 0–4095.
+
+  Centers are 2048 for stick channels and 0 for knob
+  channels, so the default (identity) matrix passes every
+  channel through unchanged.
+
+  Example – arcade to tank on the two motor outputs:
+      motorL = throttle + steer,  motorR = throttle - steer
+      mixerSetWeight(CH_MOTOR_L, CH_MOTOR_L,  MIX_ONE);
+      mixerSetWeight(CH_MOTOR_L, CH_STEERING, MIX_ONE);
+      mixerSetWeight(CH_MOTOR_R, CH_MOTOR_L,  MIX_ONE);
+      mixerSetWeight(CH_MOTOR_R, CH_MOTOR_R,  0);
+      mixerSetWeight(CH_MOTOR_R, CH_STEERING, -MIX_ONE);
+*/
+#ifndef MIXER_H
+#define MIXER_H
+
+#include <Arduino.h>
+#include "control.h"
+
+#define MIX_SHIFT 14
+#define MIX_ONE   (1 << MIX_SHIFT)
+
+void mixerInit();   // identity matrix
+
+void mixerSetWeight(uint8_t out, uint8_t in, int16_t weightQ14);
+int16_t mixerGetWeight(uint8_t out, uint8_t in);
+
+// Hot path: mixes ch[] in place
+void mixerApply(uint16_t ch[CH_COUNT]);
+
+#endif
@@ -0,0 +1,121 @@
+/*
+  output_stage.cpp
+  ------------------------------------------------------
+  Timer-driven slew-limited PWM writes.
+  See output_stage.h.
+*/
+#include "output_stage.h"
+#include "esp_timer.h"
+#include "latency.h"
+#include "failsafe.h"
+
+#define OUTPUT_PERIOD_US (1000000UL / OUTPUT_RATE_HZ)
+
+/* =====================================================
+   PER-CHANNEL SLEW LIMITS (units per tick, 0 = none)
+   ===================================================== */
+
+static const uint16_t slewPerTick[CH_COUNT] = {
+  82,   // steering: full travel in ~100 ms
+  41,   // motor L: full travel in ~200 ms
+  41,   // motor R
+  82,   // camera pan
+  0,    // LED
+  0,    // buzzer
+};
+
+/* =====================================================
+   SHARED STATE (main loop -> timer task)
+   ===================================================== */
+
+static portMUX_TYPE targetMux = portMUX_INITIALIZER_UNLOCKED;
+static uint16_t sharedTarget[CH_COUNT];
+static bool sharedSnap = false;
+static bool sharedValid = false;
+static OutputMarks sharedMarks = {};   // pending until the next tick
+
+/* =====================================================
+   TIMER-SIDE STATE
+   ===================================================== */
+
+static esp_timer_handle_t stageTimer = nullptr;
+
+static int32_t current[CH_COUNT];
+static bool started = false;
+
+static void outputStageTick(void*) {
+
+  uint16_t target[CH_COUNT];
+  bool snap, valid;
+  OutputMarks marks;
+
+  portENTER_CRITICAL(&targetMux);
+  memcpy(target, sharedTarget, sizeof(target));
+  snap = sharedSnap;
+  valid = sharedValid;
+  marks = sharedMarks;
+  sharedMarks.rx = false;
+  sharedMarks.trip = false;
+  portEXIT_CRITICAL(&targetMux);
+
+  if (!valid) return;
+
+  if (!started) {
+    for (uint8_t i = 0; i < CH_COUNT; i++) current[i] = target[i];
+    started = true;
+  }
+
+  uint16_t out[CH_COUNT];
+
+  for (uint8_t i = 0; i < CH_COUNT; i++) {
+    int32_t step = (int32_t)target[i] - current[i];
+
+    if (!snap && slewPerTick[i] != 0) {
+      int32_t lim = slewPerTick[i];
+      if (step > lim) step = lim;
+      if (step < -lim) step = -lim;
+    }
+
+    current[i] += step;
+    out[i] = (uint16_t)current[i];
+  }
+
+  controlCommitPwm(out);
+
+  if (marks.rx) latencyRecord(marks.rxUs);
+  if (marks.trip) failsafeMarkSafe(marks.lastFrameUs);
+}
+
+/* =====================================================
+   PUBLIC
+   ===================================================== */
+
+void outputStageInit() {
+  esp_timer_create_args_t args = {};
+  args.callback = outputStageTick;
+  args.dispatch_method = ESP_TIMER_TASK;
+  args.name = "out_stage";
+
+  esp_timer_create(&args, &stageTimer);
+  esp_timer_start_periodic(stageTimer, OUTPUT_PERIOD_US);
+}
+
+void outputStageSetTargets(const uint16_t ch[CH_COUNT], bool snap, const OutputMarks& marks) {
+  portENTER_CRITICAL(&targetMux);
+
+  memcpy(sharedTarget, ch, sizeof(sharedTarget));
+  sharedSnap = snap;
+  sharedValid = true;
+
+  // Keep stamps the tick has not written yet (newest frame wins)
+  if (marks.rx) {
+    sharedMarks.rx = true;
+    sharedMarks.rxUs = marks.rxUs;
+  }
+  if (marks.trip) {
+    sharedMarks.trip = true;
+    sharedMarks.lastFrameUs = marks.lastFrameUs;
+  }
+
+  portEXIT_CRITICAL(&targetMux);
+}
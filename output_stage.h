@@ -0,0 +1,61 @@
+/*
+  output_stage.h
+  ------------------------------------------------------
+  Fixed-rate PWM output stage.
+
+  controlUpdate() only publishes target channel values.
+  An esp_timer callback runs at OUTPUT_RATE_HZ, no matter
+  how long systemLoop() takes, and moves each PWM channel
+  toward its target:
+
+  • Slew limit: per-channel maximum change per tick. A
+    step from the app becomes a ramp at that rate, so
+    servos and motors move smoothly at low link rates.
+  • Otherwise the target is written at the next tick.
+    The stage never spreads a change over the expected
+    packet interval, which would delay reaching the
+    target by about one packet period.
+
+  So a new target adds at most one control period
+  (1 / OUTPUT_RATE_HZ) of latency, plus the ramp time on
+  slew-limited channels. While failsafe is active the
+  targets are written as-is (no slew), so failsafe snap
+  and ramp rates are the ones in failsafe.cpp.
+
+  Latency (latency.h) and failsafe loss -> safe stamps
+  travel with the targets and are taken in the tick that
+  writes them.
+
+  Switch outputs are NOT handled here (they stay in
+  controlUpdate()).
+*/
+#ifndef OUTPUT_STAGE_H
+#define OUTPUT_STAGE_H
+
+#include <Arduino.h>
+#include "control.h"
+
+/* Off by default: enabling it changes how the vehicle
+   handles. Steering / pan then take ~100 ms and the motors
+   ~200 ms for full travel (slewPerTick in output_stage.cpp),
+   and each new target waits for the next tick. */
+#ifndef OUTPUT_STAGE_ENABLED
+#define OUTPUT_STAGE_ENABLED 0     // 0 = controlUpdate() writes PWM directly
+#endif
+#define OUTPUT_RATE_HZ       500
+
+void outputStageInit();
+
+// Measurements completed by the tick that writes the targets
+struct OutputMarks {
+  bool rx;               // latencyRecord(rxUs)
+  uint32_t rxUs;
+  bool trip;             // failsafeMarkSafe(lastFrameUs)
+  uint32_t lastFrameUs;
+};
+
+// Latest targets (0–4095 per channel), from the main loop.
+// snap = true bypasses the slew limits (failsafe active).
+void outputStageSetTargets(const uint16_t ch[CH_COUNT], bool snap, const OutputMarks& marks);
+
+#endif
@@ -25,6 +25,8 @@ const int STATE_PACKET_SIZE = sizeof(RcPacket);
 EventPacketUnion rcEventPacket;
 const int EVENT_PACKET_SIZE = sizeof(EventPacket);
 
+const int FRAMING_PACKET_SIZE = sizeof(FramingPacket);
+
 PanelPacket panelPacket;
 const int PANEL_PACKET_SIZE = sizeof(PanelPacket);
 
@@ -34,11 +36,13 @@ const int INDICATOR_PACKET_SIZE = sizeof(IndicatorPacket);
 PlotPacket plotPacket;
 const int PLOT_PACKET_SIZE = sizeof(PlotPacket);
 
-InputPacket inputPacket;
+LatencyPacket latencyPacket;
+const int LATENCY_PACKET_SIZE = sizeof(LatencyPacket);
 
-I2CPacket i2cPacket;
+OrientationPacket orientationPacket;
+const int ORIENTATION_PACKET_SIZE = sizeof(OrientationPacket);
 
-volatile bool eventPacketArrived = false;
+InputPacket inputPacket;
 
 uint8_t calculateChecksum(const uint8_t* data, uint8_t size) {
     uint8_t c = 0;
@@ -31,7 +31,6 @@
 #ifndef PACKETS_H
 #define PACKETS_H
 #define INPUT_PACKET_SIZE 13
-#define I2C_PACKET_SIZE 14
 
 #include <Arduino.h>
 
@@ -58,9 +57,47 @@ typedef struct __attribute__((packed)) {
 } EventPacket;
 
 typedef union { EventPacket data; byte bytes[sizeof(EventPacket)]; } EventPacketUnion;
-extern EventPacketUnion rcEventPacket;
+extern EventPacketUnion rcEventPacket;   // last received, see event_queue.h
 extern const int EVENT_PACKET_SIZE;
 
+/* Framing select: DD 77 in, CC 77 ack out (see link.h) */
+typedef struct __attribute__((packed)) {
+  byte startByte1, startByte2;
+  byte mode;
+  byte checksum;
+} FramingPacket;
+extern const int FRAMING_PACKET_SIZE;
+
+/* Curve config: DD 11, sets one channel's CurveParams (see curves.h) */
+typedef struct __attribute__((packed)) {
+  byte startByte1, startByte2;
+  byte channel;
+  byte centered;
+  byte expoPct;
+  uint16_t deadband;
+  int16_t trim;
+  byte endpointLow, endpointHigh;
+  byte checksum;
+} CurveConfigPacket;
+
+/* Mixer config: DD 12, sets one Q2.14 weight (see mixer.h) */
+typedef struct __attribute__((packed)) {
+  byte startByte1, startByte2;
+  byte out, in;
+  int16_t weight;
+  byte checksum;
+} MixerConfigPacket;
+
+/* Event action config: DD 13, sets one event id's action (see control.h) */
+typedef struct __attribute__((packed)) {
+  byte startByte1, startByte2;
+  byte eventId;
+  byte actionType;
+  byte target;
+  uint16_t param;
+  byte checksum;
+} EventActionConfigPacket;
+
 /* ---- OUTPUT PACKETS ---- */
 
 typedef struct __attribute__((packed)) {
@@ -90,6 +127,25 @@ extern PlotPacket plotPacket;
 extern const int PLOT_PACKET_SIZE;
 
 
+typedef struct __attribute__((packed)) {
+  byte header1, header2;   // 0xCC 0x88
+  uint16_t count;          // samples (saturates at 65535)
+  uint16_t p50Us, p99Us, maxUs;   // saturate at 65535
+  byte checksum;
+} LatencyPacket;
+extern LatencyPacket latencyPacket;
+extern const int LATENCY_PACKET_SIZE;
+
+typedef struct __attribute__((packed)) {
+  byte header1, header2;   // 0xCC 0x99
+  int16_t rollCdeg;        // centidegrees
+  int16_t pitchCdeg;
+  int16_t yawCdeg;         // gyro-only, relative to boot
+  byte checksum;
+} OrientationPacket;
+extern OrientationPacket orientationPacket;
+extern const int ORIENTATION_PACKET_SIZE;
+
 typedef struct {
   byte h1;      // 0xCC
   byte h2;      // 0x55
@@ -105,20 +161,8 @@ typedef struct {
 
 extern InputPacket inputPacket;
 
-typedef struct {
-  byte h1;     // 0xCC
-  byte h2;     // 0x66
-  uint16_t temp;
-  uint16_t ax;
-  uint16_t ay;
-  uint16_t az;
-  byte sensorFlags;
-  byte checksum;
-} I2CPacket;
-
-extern I2CPacket i2cPacket;
-
-extern volatile bool eventPacketArrived;
+/* I2C sensor packet (0xCC 0x66) is variable length,
+   built in i2c_sensors.cpp */
 
 uint8_t calculateChecksum(const uint8_t* data, uint8_t size);
 
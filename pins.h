@@ -107,6 +107,12 @@
 
 #define MCP_ADDR 0x20
 
+/* Shared open-drain INT of every expander (external pull-up,
+   input-only GPIO). No GPIO is left unassigned across all
+   modes: 39 is also PIN_IND2 in the sensor-node map, which
+   never shares a board with the expanders. */
+#define PIN_MCP_INT 39
+
 #define PIN_FREE1 4
 #define PIN_FREE2 5
 #define PIN_FREE3 13
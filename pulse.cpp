@@ -1,69 +1,288 @@
 #include "pulse.h"
+#include "pulse_train.h"
 #include "mcp_io.h"
+#include "esp_timer.h"
 
 /* =====================================================
-   GPIO NON-BLOCKING PULSE
+   NON-BLOCKING PULSE SCHEDULER
+
+   Any number of pulses (up to PULSE_MAX per bank) can run
+   at once. Active pulses sit in a binary min-heap keyed on
+   their end time, so pulseUpdate() only looks at the heap
+   top and costs O(1) when nothing expired, O(log n) per
+   pulse that did.
+
+   Restarting a pin that is already pulsing extends its
+   pulse instead of being ignored.
+
+   With PULSE_USE_TIMER, GPIO pulses skip this scheduler
+   and are timed by esp_timer instead (see pulse_train.h).
+   MCP pulses always stay here: their writes go over I2C,
+   which must not be started from the timer task while the
+   main loop may be using the bus.
    ===================================================== */
 
-struct PulseState {
-  bool active;
+static PulseStats stats = {0, 0};
+
+#if !PULSE_USE_TIMER || USE_MCP23017
+
+#define PULSE_MAX      32
+#define PULSE_MAX_PIN  40   // GPIO 0–39 (MCP uses 0–7)
+#define PULSE_NO_SLOT  0xFF
+
+struct PulseEntry {
+  uint32_t endTime;
   uint8_t pin;
-  uint32_t startTime;
-  uint16_t duration;
 };
 
-static PulseState gpioPulse = {false, 0, 0, 0};
+struct PulseBank {
+  PulseEntry heap[PULSE_MAX];
+  uint8_t count;
+  uint8_t slotOfPin[PULSE_MAX_PIN];   // heap index, PULSE_NO_SLOT = idle
+  void (*write)(uint8_t pin, bool state);
+};
 
-void pulseStart(uint8_t pin, uint16_t durationMs) {
+/* ---------- HEAP HELPERS ---------- */
+
+// true if a ends before b (wrap-safe)
+static inline bool endsBefore(uint32_t a, uint32_t b) {
+  return (int32_t)(a - b) < 0;
+}
 
-  if (gpioPulse.active) return;
+static void heapSet(PulseBank& b, uint8_t i, const PulseEntry& e) {
+  b.heap[i] = e;
+  b.slotOfPin[e.pin] = i;
+}
 
-  digitalWrite(pin, HIGH);
+static void siftUp(PulseBank& b, uint8_t i) {
+  PulseEntry e = b.heap[i];
 
-  gpioPulse.active = true;
-  gpioPulse.pin = pin;
-  gpioPulse.startTime = millis();
-  gpioPulse.duration = durationMs;
+  while (i > 0) {
+    uint8_t parent = (i - 1) / 2;
+    if (!endsBefore(e.endTime, b.heap[parent].endTime)) break;
+    heapSet(b, i, b.heap[parent]);
+    i = parent;
+  }
+
+  heapSet(b, i, e);
 }
 
-void pulseUpdate() {
+static void siftDown(PulseBank& b, uint8_t i) {
+  PulseEntry e = b.heap[i];
+
+  while (true) {
+    uint8_t child = 2 * i + 1;
+    if (child >= b.count) break;
+
+    if (child + 1 < b.count &&
+        endsBefore(b.heap[child + 1].endTime, b.heap[child].endTime))
+      child++;
+
+    if (!endsBefore(b.heap[child].endTime, e.endTime)) break;
+
+    heapSet(b, i, b.heap[child]);
+    i = child;
+  }
+
+  heapSet(b, i, e);
+}
+
+/* ---------- BANK OPERATIONS ---------- */
+
+static void bankInit(PulseBank& b, void (*write)(uint8_t, bool)) {
+  b.count = 0;
+  memset(b.slotOfPin, PULSE_NO_SLOT, sizeof(b.slotOfPin));
+  b.write = write;
+}
+
+static void bankStart(PulseBank& b, uint8_t pin, uint16_t durationMs) {
+
+  if (pin >= PULSE_MAX_PIN) return;
 
-  if (!gpioPulse.active) return;
+  uint32_t endTime = millis() + durationMs;
+  uint8_t slot = b.slotOfPin[pin];
 
-  if (millis() - gpioPulse.startTime >= gpioPulse.duration) {
-    digitalWrite(gpioPulse.pin, LOW);
-    gpioPulse.active = false;
+  if (slot != PULSE_NO_SLOT) {
+    // Already pulsing: keep it HIGH until the later end time
+    if (endsBefore(b.heap[slot].endTime, endTime)) {
+      b.heap[slot].endTime = endTime;
+      siftDown(b, slot);
+    }
+    stats.started++;
+    return;
   }
+
+  if (b.count >= PULSE_MAX) {
+    stats.dropped++;
+    return;
+  }
+
+  b.write(pin, HIGH);
+
+  PulseEntry e = { endTime, pin };
+  b.heap[b.count] = e;
+  siftUp(b, b.count++);
+  stats.started++;
 }
 
+static void bankUpdate(PulseBank& b) {
+
+  uint32_t now = millis();
+
+  while (b.count > 0 && !endsBefore(now, b.heap[0].endTime)) {
+    uint8_t pin = b.heap[0].pin;
+
+    b.write(pin, LOW);
+    b.slotOfPin[pin] = PULSE_NO_SLOT;
+
+    b.count--;
+    if (b.count > 0) {
+      b.heap[0] = b.heap[b.count];
+      siftDown(b, 0);
+    }
+  }
+}
+
+#endif
+
 /* =====================================================
-   MCP NON-BLOCKING PULSE
+   GPIO
    ===================================================== */
 
-#if USE_MCP23017
+static void gpioWrite(uint8_t pin, bool state) {
+  digitalWrite(pin, state);
+}
 
-static PulseState mcpPulse = {false, 0, 0, 0};
+#if PULSE_USE_TIMER
 
-void mcpPulseStart(uint8_t pin, uint16_t durationMs) {
+/* -----------------------------------------------------
+   Timer-driven: pulse_train.cpp computes the edges, a
+   single esp_timer one-shot is re-armed to the earliest
+   pending edge. Edges land within the esp_timer task
+   latency, whatever the main loop is doing.
+
+   The timer callback (esp_timer task) and pulseTrainGpio()
+   (main loop) both update the trains and re-arm the timer.
+   One critical section covers the update AND the
+   stop/start: otherwise a callback could stop a timer the
+   other task had just armed for a new, earlier edge.
+
+   A spinlock, not a mutex: the callback shares the
+   esp_timer task with every other timer (the output stage
+   tick included) and must never block there. The section
+   is a few heap steps and GPIO writes.
+   ----------------------------------------------------- */
 
-  if (mcpPulse.active) return;
+static esp_timer_handle_t trainTimer = nullptr;
+static portMUX_TYPE trainMux = portMUX_INITIALIZER_UNLOCKED;
 
-  mcpWriteOutput(pin, HIGH);
+// Caller holds trainMux
+static void trainArm(uint64_t deadline) {
+  esp_timer_stop(trainTimer);
 
-  mcpPulse.active = true;
-  mcpPulse.pin = pin;
-  mcpPulse.startTime = millis();
-  mcpPulse.duration = durationMs;
+  if (deadline == PULSE_TRAIN_IDLE) return;
+
+  int64_t wait = (int64_t)deadline - esp_timer_get_time();
+  esp_timer_start_once(trainTimer, wait > 0 ? (uint64_t)wait : 1);
 }
 
-void mcpPulseUpdate() {
+static void trainTimerFired(void*) {
+  portENTER_CRITICAL(&trainMux);
+  trainArm(pulseTrainService(esp_timer_get_time()));
+  portEXIT_CRITICAL(&trainMux);
+}
+
+static void trainInit() {
+  if (trainTimer) return;
+
+  pulseTrainInit(gpioWrite);
+
+  esp_timer_create_args_t args = {};
+  args.callback = trainTimerFired;
+  args.dispatch_method = ESP_TIMER_TASK;
+  args.name = "pulse";
+
+  esp_timer_create(&args, &trainTimer);
+}
+
+bool pulseTrainGpio(uint8_t pin, uint16_t count, uint32_t onUs, uint32_t offUs) {
+  trainInit();
+
+  portENTER_CRITICAL(&trainMux);
+  uint64_t next = pulseTrainStart(esp_timer_get_time(), pin, count, onUs, offUs);
+  bool dropped = next == PULSE_TRAIN_IDLE && count != 0 && onUs != 0;
+  if (!dropped) trainArm(next);
+  portEXIT_CRITICAL(&trainMux);
+
+  if (dropped) {
+    stats.dropped++;
+    return false;
+  }
+
+  stats.started++;
+  return true;
+}
 
-  if (!mcpPulse.active) return;
+void pulseTrainGpioStop(uint8_t pin) {
+  if (!trainTimer) return;
 
-  if (millis() - mcpPulse.startTime >= mcpPulse.duration) {
-    mcpWriteOutput(mcpPulse.pin, LOW);
-    mcpPulse.active = false;
+  portENTER_CRITICAL(&trainMux);
+  trainArm(pulseTrainStop(pin));
+  portEXIT_CRITICAL(&trainMux);
+}
+
+void pulseStart(uint8_t pin, uint16_t durationMs) {
+  pulseTrainGpio(pin, 1, (uint32_t)durationMs * 1000UL, 0);
+}
+
+void pulseUpdate() {
+  // Edges are applied from the timer callback
+}
+
+#else
+
+static PulseBank gpioBank;
+static bool gpioBankReady = false;
+
+void pulseStart(uint8_t pin, uint16_t durationMs) {
+  if (!gpioBankReady) {
+    bankInit(gpioBank, gpioWrite);
+    gpioBankReady = true;
   }
+
+  bankStart(gpioBank, pin, durationMs);
+}
+
+void pulseUpdate() {
+  if (gpioBankReady) bankUpdate(gpioBank);
+}
+
+#endif
+
+const PulseStats& pulseGetStats() {
+  return stats;
+}
+
+/* =====================================================
+   MCP
+   ===================================================== */
+
+#if USE_MCP23017
+
+static PulseBank mcpBank;
+static bool mcpBankReady = false;
+
+void mcpPulseStart(uint8_t pin, uint16_t durationMs) {
+  if (!mcpBankReady) {
+    bankInit(mcpBank, mcpWriteOutput);
+    mcpBankReady = true;
+  }
+
+  bankStart(mcpBank, pin, durationMs);
+}
+
+void mcpPulseUpdate() {
+  if (mcpBankReady) bankUpdate(mcpBank);
 }
 
 #endif
@@ -4,11 +4,36 @@
 #include <Arduino.h>
 #include "user_config.h"
 
+/* ================= Stats ================= */
+
+struct PulseStats {
+  uint32_t started;   // pulses started or extended
+  uint32_t dropped;   // not started: scheduler full
+};
+
+const PulseStats& pulseGetStats();
+
 /* ================= GPIO Pulse ================= */
 
+// 1 = GPIO pulses are timed by esp_timer (µs resolution,
+//     independent of systemLoop()); pulseUpdate() is a no-op.
+//     Up to PULSE_TRAIN_MAX (32) pins at once, as in mode 0.
+// 0 = GPIO pulses are polled from pulseUpdate() in ms.
+#ifndef PULSE_USE_TIMER
+#define PULSE_USE_TIMER 1
+#endif
+
 void pulseStart(uint8_t pin, uint16_t durationMs = 50);
 void pulseUpdate();
 
+#if PULSE_USE_TIMER
+// 'count' pulses, HIGH for onUs then LOW for offUs.
+// Restarting a pin replaces its train (a single pulse
+// extends a single pulse that is still HIGH).
+bool pulseTrainGpio(uint8_t pin, uint16_t count, uint32_t onUs, uint32_t offUs);
+void pulseTrainGpioStop(uint8_t pin);
+#endif
+
 /* ================= MCP Pulse ================= */
 
 #if PROJECT_MODE == MODE_FULL_RC_MCP
@@ -0,0 +1,164 @@
+/*
+  pulse_train.cpp
+  ------------------------------------------------------
+  Pulse-train edge scheduler. See pulse_train.h.
+*/
+#include <string.h>
+#include "pulse_train.h"
+
+#define PULSE_TRAIN_NO_SLOT 0xFF
+
+struct PulseTrain {
+  bool level;          // current pin level
+  uint8_t pin;
+  uint16_t remaining;  // pulses left, including the current one
+  uint32_t onUs;
+  uint32_t offUs;
+  uint64_t nextEdgeUs;
+};
+
+static PulseTrain heap[PULSE_TRAIN_MAX];
+static uint8_t count = 0;
+static uint8_t slotOfPin[PULSE_TRAIN_MAX_PIN];   // heap index, PULSE_TRAIN_NO_SLOT = idle
+static PulseTrainWriteFn write = nullptr;
+
+/* ---------- HEAP HELPERS ---------- */
+
+static void heapSet(uint8_t i, const PulseTrain& t) {
+  heap[i] = t;
+  slotOfPin[t.pin] = i;
+}
+
+static void siftUp(uint8_t i) {
+  PulseTrain t = heap[i];
+
+  while (i > 0) {
+    uint8_t parent = (i - 1) / 2;
+    if (heap[parent].nextEdgeUs <= t.nextEdgeUs) break;
+    heapSet(i, heap[parent]);
+    i = parent;
+  }
+
+  heapSet(i, t);
+}
+
+static void siftDown(uint8_t i) {
+  PulseTrain t = heap[i];
+
+  while (true) {
+    uint8_t child = 2 * i + 1;
+    if (child >= count) break;
+
+    if (child + 1 < count && heap[child + 1].nextEdgeUs < heap[child].nextEdgeUs)
+      child++;
+
+    if (t.nextEdgeUs <= heap[child].nextEdgeUs) break;
+
+    heapSet(i, heap[child]);
+    i = child;
+  }
+
+  heapSet(i, t);
+}
+
+// Restores heap order after heap[i].nextEdgeUs changed
+static void reheap(uint8_t i) {
+  if (i > 0 && heap[i].nextEdgeUs < heap[(i - 1) / 2].nextEdgeUs) siftUp(i);
+  else siftDown(i);
+}
+
+static void removeAt(uint8_t i) {
+  slotOfPin[heap[i].pin] = PULSE_TRAIN_NO_SLOT;
+
+  count--;
+  if (i < count) {
+    heapSet(i, heap[count]);
+    reheap(i);
+  }
+}
+
+static uint64_t nextDeadline() {
+  return count > 0 ? heap[0].nextEdgeUs : PULSE_TRAIN_IDLE;
+}
+
+/* ---------- PUBLIC ---------- */
+
+void pulseTrainInit(PulseTrainWriteFn writePin) {
+  write = writePin;
+  count = 0;
+  memset(slotOfPin, PULSE_TRAIN_NO_SLOT, sizeof(slotOfPin));
+}
+
+uint64_t pulseTrainStart(uint64_t nowUs, uint8_t pin,
+                         uint16_t pulses, uint32_t onUs, uint32_t offUs) {
+
+  if (pulses == 0 || onUs == 0) return nextDeadline();
+  if (pin >= PULSE_TRAIN_MAX_PIN) return PULSE_TRAIN_IDLE;
+
+  uint64_t endUs = nowUs + onUs;
+  uint8_t slot = slotOfPin[pin];
+
+  if (slot != PULSE_TRAIN_NO_SLOT) {
+    PulseTrain& t = heap[slot];
+
+    // Already in a single pulse: keep it HIGH until the later end
+    if (pulses == 1 && t.remaining == 1 && t.level && t.nextEdgeUs > endUs)
+      endUs = t.nextEdgeUs;
+
+    t.remaining = pulses;
+    t.onUs = onUs;
+    t.offUs = offUs;
+    t.level = true;
+    t.nextEdgeUs = endUs;
+    reheap(slot);
+  } else {
+    if (count >= PULSE_TRAIN_MAX) return PULSE_TRAIN_IDLE;
+
+    PulseTrain t = { true, pin, pulses, onUs, offUs, endUs };
+    heap[count] = t;
+    siftUp(count++);
+  }
+
+  write(pin, true);
+
+  return nextDeadline();
+}
+
+uint64_t pulseTrainStop(uint8_t pin) {
+  if (pin < PULSE_TRAIN_MAX_PIN && slotOfPin[pin] != PULSE_TRAIN_NO_SLOT) {
+    write(pin, false);
+    removeAt(slotOfPin[pin]);
+  }
+
+  return nextDeadline();
+}
+
+uint64_t pulseTrainService(uint64_t nowUs) {
+
+  // Edges are applied in time order across all trains and
+  // scheduled from the previous edge, not from nowUs, so a
+  // late callback does not stretch a train.
+  while (count > 0 && heap[0].nextEdgeUs <= nowUs) {
+    PulseTrain& t = heap[0];
+
+    if (t.level) {
+      write(t.pin, false);
+      t.level = false;
+
+      if (--t.remaining == 0) {
+        removeAt(0);
+        continue;
+      }
+
+      t.nextEdgeUs += t.offUs;
+    } else {
+      write(t.pin, true);
+      t.level = true;
+      t.nextEdgeUs += t.onUs;
+    }
+
+    siftDown(0);
+  }
+
+  return nextDeadline();
+}
@@ -0,0 +1,51 @@
+/*
+  pulse_train.h
+  ------------------------------------------------------
+  Timer-independent pulse / pulse-train timing logic.
+
+  Purpose:
+  --------
+  Computes when each output pin must change level for
+  single pulses and repeating trains (N pulses with on/off
+  times in microseconds). It never reads a clock and never
+  arms a timer itself: the caller passes the current time
+  in and gets back the next deadline to arm a one-shot
+  timer for. pulse.cpp glues it to esp_timer; a desktop
+  program can drive it with a virtual clock.
+
+  Active trains sit in a binary min-heap keyed on their
+  next edge, like the polled scheduler in pulse.cpp: the
+  next deadline is the heap top (O(1)) and each edge
+  costs O(log n). Up to PULSE_TRAIN_MAX pins at once.
+
+  Not thread-safe: the caller serializes calls.
+*/
+#ifndef PULSE_TRAIN_H
+#define PULSE_TRAIN_H
+
+#include <stdint.h>
+
+#define PULSE_TRAIN_MAX      32   // trains running at once
+#define PULSE_TRAIN_MAX_PIN  40   // GPIO 0–39
+#define PULSE_TRAIN_IDLE  UINT64_MAX   // no deadline pending
+
+typedef void (*PulseTrainWriteFn)(uint8_t pin, bool level);
+
+void pulseTrainInit(PulseTrainWriteFn writePin);
+
+// Starts (or restarts) a train on pin: 'count' pulses, each
+// HIGH for onUs then LOW for offUs. Drives the pin HIGH now.
+// A single pulse on a pin that is already in a single HIGH
+// pulse extends it to the later end time instead.
+// Returns the next deadline, or PULSE_TRAIN_IDLE if no slot.
+uint64_t pulseTrainStart(uint64_t nowUs, uint8_t pin,
+                         uint16_t count, uint32_t onUs, uint32_t offUs);
+
+// Stops a train and drives the pin LOW. Returns next deadline.
+uint64_t pulseTrainStop(uint8_t pin);
+
+// Applies every edge due at or before nowUs.
+// Returns the next deadline.
+uint64_t pulseTrainService(uint64_t nowUs);
+
+#endif
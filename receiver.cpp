@@ -5,24 +5,40 @@
 
   Responsibilities:
   -----------------
-  • Read bytes from SerialBT.
-  • Maintain a sliding buffer.
-  • Detect:
+  • Bulk-read bytes from SerialBT into the ring.
+  • Maintain a circular RX buffer.
+  • Detect packet headers from the rxPackets[] registry:
         AA 55 -> State packet
-        AA 66 -> Event packet
-  • Extract full packets.
-  • Copy into union structs.
-  • Call:
-        printStatePacket()
-        printEventPacket()
+        BB 66 -> Event packet
+        DD 77 -> Framing select (see link.h)
+        DD 11 -> Curve config (see curves.h)
+        DD 12 -> Mixer weight (see mixer.h)
+        DD 13 -> Event action (see control.h)
+  • In COBS framing, split frames on 0x00 and decode
+    them before the registry lookup.
+  • Extract full packets (fixed size or length field).
+  • Verify the additive checksum of each frame.
+  • Hand each valid frame to its registered handler.
+  • Coalesce queued state packets (latest wins).
+  • Count good / bad / resynced frames.
+  • Optionally (RX_USE_TASK) run the framer in its own
+    FreeRTOS task and hand frames to the main loop
+    (state: latest-value slot, others: lock-free SPSC
+    queue).
 
   Key Design:
   -----------
-  Uses a rolling buffer to survive:
+  Uses a ring buffer + header-hunting state machine to survive:
     - Fragmented packets
     - Back-to-back packets
     - Noise
 
+  Bytes are never moved inside the buffer. The parser
+  remembers where it stopped (hunting a header, or waiting
+  for the rest of a frame) and resumes there on the next
+  call, so every received byte is inspected a bounded
+  number of times even on noisy links.
+
   This file NEVER prints raw bytes directly.
   It always uses debug.cpp helpers.
 */
@@ -31,60 +47,637 @@
 #include "packets.h"
 #include "receiver.h"
 #include "debug.h"
+#include "event_queue.h"
+#include "link.h"
+#include "cobs.h"
+#include "latency.h"
+#include "failsafe.h"
+#include "curves.h"
+#include "mixer.h"
 #include "control.h"
 
-#define RX_BUFFER_SIZE 64
+#if RX_USE_TASK
+#include "spsc_queue.h"
+#endif
 
-void handleBluetooth() {
-  static byte buffer[RX_BUFFER_SIZE];
-  static int bytesRead = 0;
-  while (SerialBT.available()) {
-    if (bytesRead < RX_BUFFER_SIZE) {
-      buffer[bytesRead++] = SerialBT.read();
-    } else {
-      memmove(buffer, buffer + 1, RX_BUFFER_SIZE - 1);
-      buffer[RX_BUFFER_SIZE - 1] = SerialBT.read();
+#define RX_BUFFER_SIZE 64   // must be a power of two
+#define RX_BUFFER_MASK (RX_BUFFER_SIZE - 1)
+
+// 1 = when several state packets are queued, only the newest
+//     valid one is decoded into rcStatePacket (events are
+//     still delivered one by one, in order)
+#define RX_COALESCE_STATE 1
+
+/* =====================================================
+   RING BUFFER
+   ===================================================== */
+
+static byte rxRing[RX_BUFFER_SIZE];
+static uint16_t rxHead = 0;   // next write position (free running)
+static uint16_t rxTail = 0;   // oldest unread byte (free running)
+
+static inline uint16_t rxCount() {
+  return (uint16_t)(rxHead - rxTail);
+}
+
+static inline byte rxPeek(uint16_t offset) {
+  return rxRing[(rxTail + offset) & RX_BUFFER_MASK];
+}
+
+static inline void rxDrop(uint16_t n) {
+  rxTail += n;
+}
+
+static void rxCopyOut(byte* dst, uint16_t pos, uint16_t len) {
+  uint16_t start = pos & RX_BUFFER_MASK;
+  uint16_t first = RX_BUFFER_SIZE - start;
+
+  if (first >= len) {
+    memcpy(dst, &rxRing[start], len);
+  } else {
+    memcpy(dst, &rxRing[start], first);
+    memcpy(dst + first, rxRing, len - first);
+  }
+}
+
+/* =====================================================
+   PACKET HANDLERS
+   ===================================================== */
+
+// Handlers get the frame and the micros() at which it was
+// completed by the framer.
+
+static void onStatePacket(const byte* frame, uint16_t len, uint32_t rxUs) {
+  memcpy(rcStatePacket.bytes, frame, len);
+  latencyMarkRx(rxUs);
+  failsafeFeed();
+}
+
+static void onEventPacket(const byte* frame, uint16_t len, uint32_t rxUs) {
+  memcpy(rcEventPacket.bytes, frame, len);
+  eventQueuePush(rcEventPacket.data.eventId, rxUs);
+}
+
+static void onFramingPacket(const byte* frame, uint16_t len, uint32_t rxUs) {
+  linkHandleFramingRequest(((const FramingPacket*)frame)->mode);
+}
+
+static void onCurveConfigPacket(const byte* frame, uint16_t len, uint32_t rxUs) {
+  const CurveConfigPacket* pkt = (const CurveConfigPacket*)frame;
+
+  CurveParams p;
+  p.centered = pkt->centered != 0;
+  p.expoPct = pkt->expoPct > 100 ? 100 : pkt->expoPct;
+  p.deadband = pkt->deadband;
+  p.trim = pkt->trim;
+  p.endpointLow = pkt->endpointLow;
+  p.endpointHigh = pkt->endpointHigh;
+
+  curveSetParams(pkt->channel, p);
+}
+
+static void onMixerConfigPacket(const byte* frame, uint16_t len, uint32_t rxUs) {
+  const MixerConfigPacket* pkt = (const MixerConfigPacket*)frame;
+  mixerSetWeight(pkt->out, pkt->in, pkt->weight);
+}
+
+static void onEventActionConfigPacket(const byte* frame, uint16_t len, uint32_t rxUs) {
+  const EventActionConfigPacket* pkt = (const EventActionConfigPacket*)frame;
+
+  EventAction a;
+  a.type = pkt->actionType;
+  a.target = pkt->target;
+  a.param = pkt->param;
+
+  controlSetEventAction(pkt->eventId, a);
+}
+
+/* =====================================================
+   PACKET REGISTRY
+
+   One row per inbound packet type. Fixed-size packets
+   set lengthOffset = -1. Variable-size packets point
+   lengthOffset at a little-endian uint16 length field
+   and the frame size becomes field + lengthExtra.
+
+   To add an inbound type, add a row here. Lookup is
+   O(1) from the first header byte, so new rows do not
+   add per-byte scanning work.
+   ===================================================== */
+
+typedef void (*RxHandler)(const byte* frame, uint16_t len, uint32_t rxUs);
+
+struct RxPacketDef {
+  byte header1, header2;
+  uint8_t length;        // fixed size, or minimum size if length field
+  int8_t lengthOffset;   // -1 = fixed size
+  uint8_t lengthExtra;   // header + length field + trailer bytes
+  uint8_t checksumTrailer;  // bytes after checksum, RX_NO_CHECKSUM = none
+  bool latestWins;          // coalesce queued frames of this type
+  RxHandler handler;
+};
+
+#define RX_NO_CHECKSUM 0xFF
+
+static const RxPacketDef rxPackets[] = {
+  // h1   h2    length                           lenOff extra csTrail latest             handler
+  { 0xAA, 0x55, sizeof(RcPacket),                -1,    0,    2,      RX_COALESCE_STATE, onStatePacket },
+  { 0xBB, 0x66, sizeof(EventPacket),             -1,    0,    0,      false,             onEventPacket },
+  { 0xDD, 0x77, sizeof(FramingPacket),           -1,    0,    0,      false,             onFramingPacket },
+  { 0xDD, 0x11, sizeof(CurveConfigPacket),       -1,    0,    0,      false,             onCurveConfigPacket },
+  { 0xDD, 0x12, sizeof(MixerConfigPacket),       -1,    0,    0,      false,             onMixerConfigPacket },
+  { 0xDD, 0x13, sizeof(EventActionConfigPacket), -1,    0,    0,      false,             onEventActionConfigPacket },
+};
+
+#define RX_PACKET_TYPES (sizeof(rxPackets) / sizeof(rxPackets[0]))
+#define RX_NO_TYPE 0xFF
+
+static uint8_t rxFirstByteMap[256];                // header1 -> first row
+static uint8_t rxNextSameHeader[RX_PACKET_TYPES];  // rows sharing header1
+
+/* =====================================================
+   FRAMER STATE MACHINE
+   ===================================================== */
+
+enum RxState : uint8_t {
+  RX_HUNT,   // looking for a two-byte header at rxTail
+  RX_BODY    // header locked at rxTail, waiting for full frame
+};
+
+static RxState rxState = RX_HUNT;
+static const RxPacketDef* rxDef = nullptr;
+static uint16_t rxFrameSize = 0;   // 0 = length field not read yet
+static bool rxSkipped = false;     // bytes discarded since last lock
+static uint32_t rxFrameUs = 0;     // micros() when the current frame completed
+
+// Newest coalesced frame seen since the last commit. It is
+// copied out of the ring so the ring can be refilled while
+// SerialBT still has a backlog; rxPoll() commits it once.
+static const RxPacketDef* rxPendingDef = nullptr;
+static uint16_t rxPendingSize = 0;
+static uint32_t rxPendingUs = 0;
+static byte rxPendingFrame[RX_BUFFER_SIZE];
+
+// COBS framing state
+static LinkFraming rxFraming = LINK_FRAMING_LEGACY;
+static uint16_t rxCobsScan = 0;      // bytes already checked for 0x00
+static bool rxCobsDiscard = false;   // dropping an oversize frame
+
+static ReceiverStats rxStats = {};
+
+static const RxPacketDef* rxMatchHeader(byte b0, byte b1) {
+  uint8_t i = rxFirstByteMap[b0];
+
+  while (i != RX_NO_TYPE) {
+    if (rxPackets[i].header2 == b1) return &rxPackets[i];
+    i = rxNextSameHeader[i];
+  }
+
+  return nullptr;
+}
+
+// Returns frame size, 0 if more bytes are needed, or
+// RX_BUFFER_SIZE + 1 if the length field is invalid.
+static uint16_t rxResolveFrameSize(const RxPacketDef* def) {
+  if (def->lengthOffset < 0) return def->length;
+
+  uint16_t off = (uint16_t)def->lengthOffset;
+  if (rxCount() < off + 2) return 0;
+
+  uint16_t size = (uint16_t)(rxPeek(off) | (rxPeek(off + 1) << 8)) + def->lengthExtra;
+
+  if (size < def->length || size > RX_BUFFER_SIZE) return RX_BUFFER_SIZE + 1;
+  return size;
+}
+
+// Same rules as rxResolveFrameSize() for a frame already
+// in a linear buffer (COBS mode).
+static bool rxFrameSizeOk(const RxPacketDef* def, const byte* frame, uint16_t size) {
+  if (def->lengthOffset < 0) return size == def->length;
+
+  uint16_t off = (uint16_t)def->lengthOffset;
+  if (size < off + 2) return false;
+
+  return size == (uint16_t)(frame[off] | (frame[off + 1] << 8)) + def->lengthExtra;
+}
+
+static bool rxChecksumOkBuf(const RxPacketDef* def, const byte* frame, uint16_t size) {
+  if (def->checksumTrailer == RX_NO_CHECKSUM) return true;
+
+  uint16_t csIndex = size - 1 - def->checksumTrailer;
+  uint8_t c = 0;
+
+  for (uint16_t i = 2; i < csIndex; i++)
+    c += frame[i];
+
+  return c == frame[csIndex];
+}
+
+// Verifies the frame in place (no copy) so bad frames
+// cost only the additive sum.
+static bool rxChecksumOk(const RxPacketDef* def, uint16_t size) {
+  if (def->checksumTrailer == RX_NO_CHECKSUM) return true;
+
+  uint16_t csIndex = size - 1 - def->checksumTrailer;
+  uint8_t c = 0;
+
+  for (uint16_t i = 2; i < csIndex; i++)
+    c += rxPeek(i);
+
+  return c == rxPeek(csIndex);
+}
+
+/* =====================================================
+   DELIVERY
+
+   Direct mode: the frame is handed to its handler right
+   away, from handleBluetooth() in the main loop.
+
+   Task mode (RX_USE_TASK): the RX task copies the frame
+   out and handleBluetooth() runs the handlers on the main
+   loop side, so packet globals and controlHandleEvent()
+   are only touched by one task. Coalesced (latest-wins)
+   frames go into a single latest-value slot that the RX
+   task overwrites; everything else goes through a
+   lock-free SPSC queue, so a stalled main loop loses old
+   state frames, never events.
+   ===================================================== */
+
+#if RX_USE_TASK
+
+struct RxMessage {
+  uint8_t type;                 // index into rxPackets[]
+  uint8_t len;
+  uint32_t rxUs;                // frame completion time
+  byte bytes[RX_BUFFER_SIZE];
+};
+
+static SpscQueue<RxMessage, RX_QUEUE_DEPTH> rxHandoff;
+
+static portMUX_TYPE rxLatestMux = portMUX_INITIALIZER_UNLOCKED;
+static RxMessage rxLatest;      // newest latest-wins frame
+static bool rxLatestFresh = false;
+
+static void rxDeliver(const RxPacketDef* def, uint16_t pos, uint16_t size) {
+  RxMessage* msg = rxHandoff.pushSlot();
+
+  if (!msg) {
+    rxStats.handoffDrops++;
+    return;
+  }
+
+  msg->type = (uint8_t)(def - rxPackets);
+  msg->len = (uint8_t)size;
+  msg->rxUs = rxFrameUs;
+  rxCopyOut(msg->bytes, pos, size);
+  rxHandoff.pushCommit();
+}
+
+static void rxDeliverBytes(const RxPacketDef* def, const byte* frame, uint16_t size) {
+  RxMessage* msg = rxHandoff.pushSlot();
+
+  if (!msg) {
+    rxStats.handoffDrops++;
+    return;
+  }
+
+  msg->type = (uint8_t)(def - rxPackets);
+  msg->len = (uint8_t)size;
+  msg->rxUs = rxFrameUs;
+  memcpy(msg->bytes, frame, size);
+  rxHandoff.pushCommit();
+}
+
+static void rxDeliverLatest(const RxPacketDef* def, const byte* frame, uint16_t size, uint32_t rxUs) {
+  portENTER_CRITICAL(&rxLatestMux);
+  if (rxLatestFresh) rxStats.coalesced++;   // main loop never saw the previous one
+  rxLatest.type = (uint8_t)(def - rxPackets);
+  rxLatest.len = (uint8_t)size;
+  rxLatest.rxUs = rxUs;
+  memcpy(rxLatest.bytes, frame, size);
+  rxLatestFresh = true;
+  portEXIT_CRITICAL(&rxLatestMux);
+}
+
+#else
+
+static byte rxFrame[RX_BUFFER_SIZE];
+
+static void rxDeliver(const RxPacketDef* def, uint16_t pos, uint16_t size) {
+  rxCopyOut(rxFrame, pos, size);
+  def->handler(rxFrame, size, rxFrameUs);
+}
+
+static void rxDeliverBytes(const RxPacketDef* def, const byte* frame, uint16_t size) {
+  def->handler(frame, size, rxFrameUs);
+}
+
+static void rxDeliverLatest(const RxPacketDef* def, const byte* frame, uint16_t size, uint32_t rxUs) {
+  def->handler(frame, size, rxUs);
+}
+
+#endif
+
+static void rxCommitPending() {
+  if (!rxPendingDef) return;
+
+  rxDeliverLatest(rxPendingDef, rxPendingFrame, rxPendingSize, rxPendingUs);
+  rxPendingDef = nullptr;
+}
+
+static void rxResetFramer() {
+  rxState = RX_HUNT;
+  rxCobsScan = 0;
+  rxCobsDiscard = false;
+}
+
+// Legacy framing: one step of the header-hunting state
+// machine. Returns false when more bytes are needed.
+static bool rxStepLegacy() {
+  if (rxState == RX_HUNT) {
+    uint16_t n = rxCount();
+
+    if (n == 0) return false;
+
+    byte b0 = rxPeek(0);
+
+    if (rxFirstByteMap[b0] == RX_NO_TYPE) {
+      rxDrop(1);
+      rxSkipped = true;
+      return true;
+    }
+
+    // Possible header start: need the second byte to decide
+    if (n < 2) return false;
+
+    rxDef = rxMatchHeader(b0, rxPeek(1));
+
+    if (!rxDef) {
+      rxDrop(1);
+      rxSkipped = true;
+      return true;
+    }
+
+    if (rxSkipped) {
+      rxStats.resyncs++;
+      rxSkipped = false;
     }
+
+    rxState = RX_BODY;
+    rxFrameSize = 0;
   }
 
+  // RX_BODY
+  if (rxFrameSize == 0) {
+    rxFrameSize = rxResolveFrameSize(rxDef);
+
+    if (rxFrameSize == 0) return false;
+
+    if (rxFrameSize > RX_BUFFER_SIZE) {
+      // Bad length field: treat header as noise
+      rxStats.badFrames++;
+      rxDrop(1);
+      rxSkipped = true;
+      rxState = RX_HUNT;
+      return true;
+    }
+  }
+
+  if (rxCount() < rxFrameSize) return false;
+
+  if (!rxChecksumOk(rxDef, rxFrameSize)) {
+    // Header matched but payload is corrupt: resync one
+    // byte past the header start instead of eating the frame
+    rxStats.badFrames++;
+    rxDrop(1);
+    rxSkipped = true;
+    rxState = RX_HUNT;
+    return true;
+  }
+
+  rxStats.goodFrames++;
+  rxFrameUs = micros();
+
+  if (rxDef->latestWins) {
+    // Defer the decode: a newer frame may follow in the backlog
+    if (rxPendingDef == rxDef) rxStats.coalesced++;
+    else if (rxPendingDef) rxCommitPending();
+
+    rxCopyOut(rxPendingFrame, rxTail, rxFrameSize);
+    rxPendingDef = rxDef;
+    rxPendingSize = rxFrameSize;
+    rxPendingUs = rxFrameUs;
+  } else {
+    rxDeliver(rxDef, rxTail, rxFrameSize);
+  }
+
+  rxDrop(rxFrameSize);
+  rxState = RX_HUNT;
+  return true;
+}
+
+// COBS framing: validates and delivers one decoded frame.
+static void rxCobsFrame(uint16_t encLen) {
+  static byte enc[RX_BUFFER_SIZE];
+  static byte dec[RX_BUFFER_SIZE];
+
+  rxCopyOut(enc, rxTail, encLen);
+  uint16_t size = cobsDecode(enc, encLen, dec);
+
+  const RxPacketDef* def = size >= 2 ? rxMatchHeader(dec[0], dec[1]) : nullptr;
+
+  if (!def || !rxFrameSizeOk(def, dec, size) || !rxChecksumOkBuf(def, dec, size)) {
+    rxStats.badFrames++;
+    return;
+  }
+
+  rxStats.goodFrames++;
+  rxFrameUs = micros();
+
+  if (def->latestWins) {
+    if (rxPendingDef == def) rxStats.coalesced++;
+    else if (rxPendingDef) rxCommitPending();
+
+    memcpy(rxPendingFrame, dec, size);
+    rxPendingDef = def;
+    rxPendingSize = size;
+    rxPendingUs = rxFrameUs;
+  } else {
+    rxDeliverBytes(def, dec, size);
+  }
+}
+
+// COBS framing: finds the next 0x00 delimiter, resuming the
+// search where the last call stopped. Returns false when
+// more bytes are needed.
+static bool rxStepCobs() {
+  uint16_t n = rxCount();
+
+  while (rxCobsScan < n && rxPeek(rxCobsScan) != 0x00)
+    rxCobsScan++;
+
+  if (rxCobsScan == n) {
+    if (n == RX_BUFFER_SIZE) {
+      // No delimiter in a full ring: frame too long, skip to next 0x00
+      if (!rxCobsDiscard) rxStats.badFrames++;
+      rxDrop(n);
+      rxCobsScan = 0;
+      rxCobsDiscard = true;
+    }
+    return false;
+  }
+
+  uint16_t encLen = rxCobsScan;
+
+  if (rxCobsDiscard) {
+    rxStats.resyncs++;
+    rxCobsDiscard = false;
+  } else if (encLen > 0) {
+    rxCobsFrame(encLen);
+  }
+
+  rxDrop(encLen + 1);
+  rxCobsScan = 0;
+  return true;
+}
+
+static void rxParseFrames() {
   while (true) {
-    int packetStart = -1;
-    int packetType = 0;  // 1 = STATE, 2 = EVENT
-
-    for (int i = 0; i <= bytesRead - 2; i++) {
-
-      // --- STATE packet header ---
-      if (buffer[i] == 0xAA && buffer[i + 1] == 0x55) {
-        if (bytesRead - i >= STATE_PACKET_SIZE) {
-          packetStart = i;
-          packetType = 1;
-          break;
-        }
-      }
 
-      // --- EVENT packet header ---
-      if (buffer[i] == 0xBB && buffer[i + 1] == 0x66) {
-        if (bytesRead - i >= EVENT_PACKET_SIZE) {
-          packetStart = i;
-          packetType = 2;
-          break;
-        }
-      }
+    // A FramingPacket handler may switch framing mid-pass
+    LinkFraming mode = linkGetFraming();
+    if (mode != rxFraming) {
+      rxFraming = mode;
+      rxResetFramer();
     }
 
-    if (packetStart == -1) break;
+    bool more = (rxFraming == LINK_FRAMING_COBS) ? rxStepCobs() : rxStepLegacy();
+    if (!more) return;
+  }
+}
+
+#if RX_USE_TASK
+static void rxPoll();
+
+static void rxTask(void*) {
+  for (;;) {
+    rxPoll();
+    vTaskDelay(1);
+  }
+}
+#endif
+
+/* =====================================================
+   PUBLIC
+   ===================================================== */
+
+void receiverInit() {
+  memset(rxFirstByteMap, RX_NO_TYPE, sizeof(rxFirstByteMap));
+
+  // Build chains back to front so the first table row wins
+  for (int i = RX_PACKET_TYPES - 1; i >= 0; i--) {
+    byte h1 = rxPackets[i].header1;
+    rxNextSameHeader[i] = rxFirstByteMap[h1];
+    rxFirstByteMap[h1] = i;
+  }
+
+  rxHead = rxTail = 0;
+  rxResetFramer();
+  rxSkipped = false;
+
+#if RX_USE_TASK
+  xTaskCreatePinnedToCore(rxTask, "bt_rx", RX_TASK_STACK, nullptr,
+                          RX_TASK_PRIORITY, nullptr, RX_TASK_CORE);
+#endif
+}
+
+const ReceiverStats& receiverGetStats() {
+  return rxStats;
+}
+
+// Copies up to 'avail' bytes from SerialBT straight into the
+// ring in at most two bulk reads (before and after the wrap).
+static uint16_t rxFill(uint16_t avail) {
+  uint16_t space = RX_BUFFER_SIZE - rxCount();
+  uint16_t want = avail < space ? avail : space;
+  uint16_t got = 0;
+
+  while (got < want) {
+    uint16_t start = rxHead & RX_BUFFER_MASK;
+    uint16_t chunk = RX_BUFFER_SIZE - start;
+    if (chunk > want - got) chunk = want - got;
+
+    uint16_t n = SerialBT.readBytes(&rxRing[start], chunk);
+    rxStats.bulkReads++;
+    if (n == 0) break;
+
+    rxHead += n;
+    got += n;
+  }
+
+  rxStats.bytesIn += got;
+  return got;
+}
+
+// Reads everything SerialBT has and decodes it.
+static void rxPoll() {
+  uint32_t t0 = micros();
+
+  int avail;
+  while ((avail = SerialBT.available()) > 0) {
 
-    if (packetType == 1) {
-      memcpy(rcStatePacket.bytes, &buffer[packetStart], STATE_PACKET_SIZE);
-    } else if (packetType == 2) {
-      memcpy(rcEventPacket.bytes, &buffer[packetStart], EVENT_PACKET_SIZE);
-      eventPacketArrived = true;
-      controlHandleEvent(rcEventPacket.data.eventId);
+    if (rxCount() == RX_BUFFER_SIZE) {
+      // Buffer full: frame what we have to make room. The
+      // newest state frame stays pending until the backlog
+      // is drained, so a long backlog is decoded once.
+      rxParseFrames();
+
+      if (rxCount() == RX_BUFFER_SIZE) {
+        // Still full (cannot happen with frames < buffer size):
+        // drop oldest byte and re-hunt
+        rxDrop(1);
+        rxResetFramer();
+      }
     }
 
-    int removeCount = packetStart + (packetType == 1 ? STATE_PACKET_SIZE : EVENT_PACKET_SIZE);
+    if (rxFill((uint16_t)(avail < RX_BUFFER_SIZE ? avail : RX_BUFFER_SIZE)) == 0)
+      break;
+  }
+
+  rxParseFrames();
+  rxCommitPending();
+
+  uint32_t dt = micros() - t0;
+  rxStats.lastCallUs = dt;
+  if (dt > rxStats.maxCallUs) rxStats.maxCallUs = dt;
+}
 
-    memmove(buffer, buffer + removeCount, bytesRead - removeCount);
-    bytesRead -= removeCount;
+void handleBluetooth() {
+#if RX_USE_TASK
+  // Consumer side: run handlers for frames framed by rxTask
+  RxMessage* msg;
+  while ((msg = rxHandoff.peekSlot()) != nullptr) {
+    rxPackets[msg->type].handler(msg->bytes, msg->len, msg->rxUs);
+    rxHandoff.popCommit();
   }
+
+  static RxMessage latest;
+  bool fresh;
+
+  portENTER_CRITICAL(&rxLatestMux);
+  fresh = rxLatestFresh;
+  if (fresh) {
+    latest.type = rxLatest.type;
+    latest.len = rxLatest.len;
+    latest.rxUs = rxLatest.rxUs;
+    memcpy(latest.bytes, rxLatest.bytes, rxLatest.len);
+    rxLatestFresh = false;
+  }
+  portEXIT_CRITICAL(&rxLatestMux);
+
+  if (fresh)
+    rxPackets[latest.type].handler(latest.bytes, latest.len, latest.rxUs);
+#else
+  rxPoll();
+#endif
 }
@@ -5,16 +5,18 @@
 
   Provides:
   ----------
+  • receiverInit()
   • handleBluetooth()
+  • receiverGetStats()
 
   Purpose:
   --------
   This module:
     - Reads raw Bluetooth bytes
-    - Stores them in a rolling buffer
-    - Searches for packet headers
+    - Stores them in a ring buffer
+    - Looks up packet headers in a type registry
     - Extracts complete packets
-    - Verifies them
+    - Verifies their checksum
     - Calls debug print functions
 
   Called from:
@@ -23,5 +25,42 @@
 */
 #ifndef RECEIVER_H
 #define RECEIVER_H
+
+#include <stdint.h>
+
+/* =====================================================
+   RX TASK MODE
+
+   0 = handleBluetooth() reads and decodes SerialBT from
+       the main loop (default).
+   1 = a dedicated FreeRTOS task reads and frames packets;
+       handleBluetooth() only runs the packet handlers for
+       frames it queued, so RX latency no longer depends on
+       how long the rest of systemLoop() takes.
+   ===================================================== */
+#ifndef RX_USE_TASK
+#define RX_USE_TASK      0
+#endif
+#define RX_TASK_STACK    4096
+#define RX_TASK_PRIORITY 2   // above loopTask (1)
+#define RX_TASK_CORE     1
+#define RX_QUEUE_DEPTH   16  // event/config frames, power of two
+
+/* Frame counters, readable at runtime */
+struct ReceiverStats {
+  uint32_t goodFrames;   // checksum OK, handed to handler
+  uint32_t badFrames;    // header matched, checksum or length bad
+  uint32_t resyncs;      // header locked after discarding bytes
+  uint32_t coalesced;    // valid state frames superseded unread
+  uint32_t handoffDrops; // RX_USE_TASK: event/config frames lost, queue full
+
+  uint32_t bytesIn;      // bytes pulled from SerialBT
+  uint32_t bulkReads;    // SerialBT.readBytes() calls
+  uint32_t lastCallUs;   // time spent in last handleBluetooth()
+  uint32_t maxCallUs;    // worst handleBluetooth() time seen
+};
+
+void receiverInit();
 void handleBluetooth();
+const ReceiverStats& receiverGetStats();
 #endif
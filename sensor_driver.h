@@ -0,0 +1,42 @@
+/*
+  sensor_driver.h
+  ------------------------------------------------------
+  Interface every I2C sensor driver implements.
+
+  Lifecycle:
+  ----------
+  • probe()      at boot, may block: true if the chip answers.
+  • configure()  at boot, only if probed: may block.
+  • sample()     at run time, every periodMs (0 = every
+                 loop). Must not block: queue I2C work on
+                 the shared bus and collect it next call.
+  • read()       latest values (valueCount int16s), false
+                 until the first sample completed (a probe
+                 that already read the values may seed it).
+
+  Drivers are listed in the registry in i2c_sensors.cpp.
+*/
+#ifndef SENSOR_DRIVER_H
+#define SENSOR_DRIVER_H
+
+#include <Arduino.h>
+
+#define SENSOR_MAX_VALUES 4
+
+/* Telemetry ids (stable, the app keys on them) */
+#define SENSOR_ID_TEMP  0x01
+#define SENSOR_ID_ACCEL 0x02
+
+struct SensorDriver {
+  const char* name;
+  uint8_t id;
+  uint8_t valueCount;
+  uint16_t periodMs;
+
+  bool (*probe)();
+  void (*configure)();
+  void (*sample)();
+  bool (*read)(int16_t* values);
+};
+
+#endif
@@ -0,0 +1,92 @@
+/*
+  spsc_queue.h
+  ------------------------------------------------------
+  Lock-free single-producer / single-consumer ring queue.
+
+  Purpose:
+  --------
+  Hands data from one task (producer) to another task
+  (consumer) without mutexes or critical sections.
+
+  Rules:
+  ------
+  • Exactly ONE task may call push()/pushSlot()/pushCommit().
+  • Exactly ONE task may call pop()/peekSlot()/popCommit().
+  • N must be a power of two. One slot is never wasted:
+    indices run free and are masked on access.
+
+  This header has no Arduino dependencies so it also
+  builds on a desktop compiler.
+*/
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+template <typename T, size_t N>
+class SpscQueue {
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscQueue size must be a power of two");
+
+public:
+  SpscQueue() : head(0), tail(0) {}
+
+  /* ---------- PRODUCER ---------- */
+
+  // Slot to fill in place, or nullptr if full
+  T* pushSlot() {
+    uint32_t h = head.load(std::memory_order_relaxed);
+    if (h - tail.load(std::memory_order_acquire) >= N) return nullptr;
+    return &items[h & (N - 1)];
+  }
+
+  // Publish the slot returned by pushSlot()
+  void pushCommit() {
+    head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  bool push(const T& item) {
+    T* slot = pushSlot();
+    if (!slot) return false;
+    *slot = item;
+    pushCommit();
+    return true;
+  }
+
+  /* ---------- CONSUMER ---------- */
+
+  // Oldest item, or nullptr if empty
+  T* peekSlot() {
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    if (head.load(std::memory_order_acquire) == t) return nullptr;
+    return &items[t & (N - 1)];
+  }
+
+  // Release the slot returned by peekSlot()
+  void popCommit() {
+    tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  bool pop(T& out) {
+    T* slot = peekSlot();
+    if (!slot) return false;
+    out = *slot;
+    popCommit();
+    return true;
+  }
+
+  /* ---------- EITHER SIDE (approximate) ---------- */
+
+  size_t size() const {
+    return (size_t)(head.load(std::memory_order_acquire) -
+                    tail.load(std::memory_order_acquire));
+  }
+
+private:
+  T items[N];
+  std::atomic<uint32_t> head;   // written by producer only
+  std::atomic<uint32_t> tail;   // written by consumer only
+};
+
+#endif
@@ -10,6 +10,8 @@
 #include "i2c_sensors.h"
 #include "debug_config.h"
 #include "i2c_bus.h"
+#include "mcp_io.h"
+#include "link.h"
 
 
 static void serialInit() {
@@ -24,6 +26,7 @@ static void serialInit() {
 
 static void bluetoothInit() {
   SerialBT.begin(DEVICE_NAME);
+  receiverInit();
 
 #if DEBUG_ENABLED
   Serial.println("ESP32 Bluetooth Receiver Ready.");
@@ -42,22 +45,25 @@ static void hardwareInit() {
   mcpInit();
 #endif
 
-#if USE_I2C_SENSORS
+  // Not behind a feature flag: probing finds what is
+  // fitted, absent sensors are never touched again
   i2cSensorsInit();
-#endif
 }
 
 void systemInit() {
   serialInit();
   bluetoothInit();
   hardwareInit();
+  controlInit();
 }
 
 void systemLoop() {
+  linkUpdate();
   handleBluetooth();
   sendTelemetryIfDue();
   controlUpdate();
   inputUpdate();
+  i2cSensorsUpdate();
   sendI2CTelemetry();
 
 #if DBG_STICKS
@@ -80,4 +86,20 @@ void systemLoop() {
 #if DBG_SWITCHES
   debugSwitches();
 #endif
+
+#if DBG_RX_STATS
+  debugReceiverStats();
+#endif
+
+#if DBG_LATENCY
+  debugLatency();
+#endif
+
+#if DBG_FAILSAFE
+  debugFailsafe();
+#endif
+
+#if DBG_MCP_STATS && USE_MCP23017
+  debugMcpStats();
+#endif
 }
\ No newline at end of file
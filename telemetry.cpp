@@ -12,10 +12,13 @@
 #include <string.h>
 
 #include "bluetooth.h"
+#include "link.h"
 #include "packets.h"
 #include "telemetry.h"
 #include "telemetry_source.h"
 #include "debug_config.h"
+#include "latency.h"
+#include "attitude.h"
 
 /* =====================================================
    TIMING
@@ -25,6 +28,8 @@ const unsigned long indicatorInterval = 500;
 const unsigned long plotInterval = 50;
 const unsigned long resendWindow = 300;
 const unsigned long resendInterval = 100;
+const unsigned long latencyInterval = 1000;
+const unsigned long orientationInterval = 50;
 
 /* =====================================================
    STATE
@@ -32,6 +37,8 @@ const unsigned long resendInterval = 100;
 
 static unsigned long lastIndicatorSend = 0;
 static unsigned long lastPlotSend = 0;
+static unsigned long lastLatencySend = 0;
+static unsigned long lastOrientationSend = 0;
 
 static uint16_t lastPanelL = 0;
 static uint16_t lastPanelR = 0;
@@ -43,6 +50,8 @@ static unsigned long panelRetryUntil = 0;
 static unsigned long lastPanelTx = 0;
 
 static bool configSent = false;
+static bool snapshotRequested = false;
+static bool indicatorRequested = false;
 
 /* =====================================================
    CONFIG LABELS
@@ -118,7 +127,7 @@ void sendConfigTelemetry() {
 
   if (SerialBT.hasClient()) {
     Serial.println("Telemetry config sent...");
-    SerialBT.write(buf, idx);
+    linkWrite(buf, idx);
   }
 }
 
@@ -138,6 +147,23 @@ static void computeChecksum(void* pkt, uint8_t size) {
   b[size - 1] = c;
 }
 
+static uint16_t sat16(uint32_t v) {
+  return v > 0xFFFF ? 0xFFFF : (uint16_t)v;
+}
+
+/* =====================================================
+   SNAPSHOT (send every periodic packet on next call)
+   ===================================================== */
+
+void telemetryRequestSnapshot() {
+  snapshotRequested = true;
+}
+
+// Digital inputs changed: send the indicator packet now
+void telemetryRequestIndicator() {
+  indicatorRequested = true;
+}
+
 /* =====================================================
    MAIN TELEMETRY LOOP
    ===================================================== */
@@ -158,6 +184,12 @@ void sendTelemetryIfDue() {
 
   unsigned long t = millis();
 
+  bool snapshot = snapshotRequested;
+  snapshotRequested = false;
+
+  bool indicatorNow = indicatorRequested;
+  indicatorRequested = false;
+
   // Update debug input if active
   telemetrySourceUpdate();
 
@@ -184,7 +216,7 @@ void sendTelemetryIfDue() {
     panelPacket.panelStates = 0b00000111;  // example state bits
 
     computeChecksum(&panelPacket, PANEL_PACKET_SIZE);
-    SerialBT.write((byte*)&panelPacket, PANEL_PACKET_SIZE);
+    linkWrite((byte*)&panelPacket, PANEL_PACKET_SIZE);
 
     lastPanelTx = now;
   }
@@ -197,7 +229,7 @@ void sendTelemetryIfDue() {
 
   /* ---------- INDICATOR ---------- */
 
-  if (t - lastIndicatorSend > indicatorInterval) {
+  if (snapshot || indicatorNow || t - lastIndicatorSend > indicatorInterval) {
 
     lastIndicatorSend = t;
 
@@ -209,12 +241,12 @@ void sendTelemetryIfDue() {
     indicatorPacket.digitalMask  = getIndicatorDigitalMask();
 
     computeChecksum(&indicatorPacket, INDICATOR_PACKET_SIZE);
-    SerialBT.write((byte*)&indicatorPacket, INDICATOR_PACKET_SIZE);
+    linkWrite((byte*)&indicatorPacket, INDICATOR_PACKET_SIZE);
   }
 
   /* ---------- PLOT ---------- */
 
-  if (t - lastPlotSend > plotInterval) {
+  if (snapshot || t - lastPlotSend > plotInterval) {
 
     lastPlotSend = t;
 
@@ -247,6 +279,47 @@ void sendTelemetryIfDue() {
 
     buf[idx++] = checksum;
 
-    SerialBT.write(buf, idx);
+    linkWrite(buf, idx);
+  }
+
+  /* ---------- LATENCY ---------- */
+
+  if (snapshot || t - lastLatencySend > latencyInterval) {
+
+    lastLatencySend = t;
+
+    LatencySummary lat;
+    latencyGetSummary(lat);
+
+    latencyPacket.header1 = 0xCC;
+    latencyPacket.header2 = 0x88;
+    latencyPacket.count = sat16(lat.count);
+    latencyPacket.p50Us = sat16(lat.p50Us);
+    latencyPacket.p99Us = sat16(lat.p99Us);
+    latencyPacket.maxUs = sat16(lat.maxUs);
+
+    computeChecksum(&latencyPacket, LATENCY_PACKET_SIZE);
+    linkWrite((byte*)&latencyPacket, LATENCY_PACKET_SIZE);
+  }
+
+  /* ---------- ORIENTATION ---------- */
+
+  if (snapshot || t - lastOrientationSend > orientationInterval) {
+
+    lastOrientationSend = t;
+
+    Attitude att;
+    attitudeGet(att);
+
+    if (att.valid) {
+      orientationPacket.header1 = 0xCC;
+      orientationPacket.header2 = 0x99;
+      orientationPacket.rollCdeg = att.rollCdeg;
+      orientationPacket.pitchCdeg = att.pitchCdeg;
+      orientationPacket.yawCdeg = att.yawCdeg;
+
+      computeChecksum(&orientationPacket, ORIENTATION_PACKET_SIZE);
+      linkWrite((byte*)&orientationPacket, ORIENTATION_PACKET_SIZE);
+    }
   }
 }
@@ -10,6 +10,8 @@
   • sendIndicatorTelemetry()
   • sendPlotTelemetry()
   • sendConfigTelemetry()
+  • telemetryRequestSnapshot()
+  • telemetryRequestIndicator()
 
   Purpose:
   --------
@@ -19,6 +21,8 @@
 #ifndef TELEMETRY_H
 #define TELEMETRY_H
 void sendTelemetryIfDue();
+void telemetryRequestSnapshot();
+void telemetryRequestIndicator();
 void sendConfigTelemetry();
 void readPlotFromSerial();
 #endif
@@ -0,0 +1,56 @@
+/*
+  temp_sensor.cpp
+  ------------------------------------------------------
+  TMP102-style temperature driver. See temp_sensor.h.
+
+  Reports the raw temperature register, as before.
+*/
+#include "temp_sensor.h"
+#include "i2c_bus.h"
+
+#define TEMP_PERIOD_MS 250     // slow sensor, converts at ~4 Hz
+
+static I2cTxn txn;
+static uint8_t buf[2];
+
+static int16_t value = 0;
+static bool valid = false;
+
+static void tempStore() {
+  value = (int16_t)(((uint16_t)buf[0] << 8) | buf[1]);
+  valid = true;
+}
+
+// The probe reads the temperature register, so its result
+// seeds the first reading instead of waiting a full period
+static bool tempProbe() {
+  i2cTxnRead(txn, I2C_ADDR_TEMP, 0x00, buf, 2);
+  if (!i2cTransfer(txn, I2C_PRIO_SENSOR)) return false;
+
+  tempStore();
+  return true;
+}
+
+static void tempConfigure() {
+  // Power-on defaults: continuous conversion
+}
+
+static void tempSample() {
+  if (i2cPending(txn)) return;
+
+  // Collect the read queued last period, then queue the next
+  if (i2cTakeResult(txn) == I2C_DONE) tempStore();
+
+  i2cTxnRead(txn, I2C_ADDR_TEMP, 0x00, buf, 2);
+  i2cSubmit(txn, I2C_PRIO_SENSOR);
+}
+
+static bool tempRead(int16_t* values) {
+  values[0] = value;
+  return valid;
+}
+
+const SensorDriver tempSensorDriver = {
+  "temp", SENSOR_ID_TEMP, 1, TEMP_PERIOD_MS,
+  tempProbe, tempConfigure, tempSample, tempRead
+};
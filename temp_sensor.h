@@ -0,0 +1,15 @@
+/*
+  temp_sensor.h
+  ------------------------------------------------------
+  TMP102-style temperature sensor (16-bit register 0x00).
+*/
+#ifndef TEMP_SENSOR_H
+#define TEMP_SENSOR_H
+
+#include "sensor_driver.h"
+
+#define I2C_ADDR_TEMP 0x48
+
+extern const SensorDriver tempSensorDriver;
+
+#endif